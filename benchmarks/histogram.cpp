@@ -0,0 +1,138 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Benchmark: dense vector vs. hash histogram
+//      -------------------------------------------------------------------------------------------------------
+//          It counts the same microstates (taken from a white noise time series) with count_dense and count_sparse
+//  on the thread pool, as Probabilities does, including the allocation, the reduction of the threads and the
+//  normalization, for hypervolumes from 16 up to a maximum (27 by default, the dense histograms need threads * 8 *
+//  2^hypervolume bytes). The microstates are evaluated once before, so only the histograms are timed. The first
+//  hypervolume where the hash histogram wins, minus one, is the value to use as DEFAULT_HYPERVOLUME_TO_DICTIONARY
+//  (see settings.h).
+//
+//      Build and run with CMake from the repository root:
+//          cmake -S benchmarks -B build-benchmarks && cmake --build build-benchmarks
+//          ./build-benchmarks/histogram [samples = 1000000] [threads = 4] [maximum hypervolume = 27]
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+//                * Include the internal headers
+#include "counting.h"
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    using Clock = std::chrono::steady_clock;
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Microstates of a 1 x hypervolume structure over white noise.
+    std::vector<uint64_t> microstates(const size_t hypervolume, const size_t samples) {
+        constexpr size_t length = 100000;
+
+        std::mt19937_64 gen(42);
+        std::normal_distribution<double> noise;
+        std::vector<double> data(length);
+        for (auto &v : data) v = noise(gen);
+
+        const RecurrenceMicrostates::Settings settings({1, hypervolume}, 1);
+        const RecurrenceMicrostates::Stencil stencil(settings, {1, 1}, {1, 1}, 1);
+        const RecurrenceMicrostates::Recurrence recurrence(METRIC_EUCLIDEAN, 0.5, 1);
+
+        std::uniform_int_distribution<size_t> dist_x(0, length - 1);
+        std::uniform_int_distribution<size_t> dist_y(0, length - hypervolume);
+
+        std::vector<uint64_t> result(samples);
+        for (auto &m : result) {
+            const auto *x = data.data() + dist_x(gen);
+            const auto *y = data.data() + dist_y(gen);
+            m = recurrence(x, stencil.offsets_x(), 1, y, stencil.offsets_y(), 1, stencil.cells());
+        }
+
+        return result;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The counting task of the library over the precomputed microstates.
+    auto replay(const std::vector<uint64_t> &input) {
+        return [&input](const size_t begin, const size_t end, auto &&count) {
+            for (auto s = begin; s < end; s++) count(input[s]);
+            return end - begin;
+        };
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Time (in ms) to count with count_dense, one dense histogram per thread of the pool.
+    double dense(const std::vector<uint64_t> &input, const size_t hypervolume, const unsigned int threads, size_t &distinct) {
+        const RecurrenceMicrostates::Settings settings({1, hypervolume}, threads, MODE_FORCE_VECTOR);
+        const auto start = Clock::now();
+
+        std::vector<size_t> counts;
+        const auto counter = RecurrenceMicrostates::count_dense(settings, input.size(), DEFAULT_CHUNK, replay(input), counts);
+
+        std::vector<double> result;
+        RecurrenceMicrostates::normalize_counts(settings, counts, counter, result);
+
+        const auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        distinct = 0;
+        for (const auto c : counts) distinct += c > 0;
+        return elapsed;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Time (in ms) to count with count_sparse, one hash histogram per thread of the pool.
+    double hashed(const std::vector<uint64_t> &input, const size_t hypervolume, const unsigned int threads, size_t &distinct) {
+        const RecurrenceMicrostates::Settings settings({1, hypervolume}, threads, MODE_FORCE_DICTIONARY);
+        const auto start = Clock::now();
+
+        RecurrenceMicrostates::FlatHistogram histogram;
+        const auto counter = RecurrenceMicrostates::count_sparse(settings, input.size(), DEFAULT_CHUNK, replay(input), histogram);
+
+        std::vector<uint64_t> keys;
+        std::vector<size_t> counts;
+        histogram.sorted(keys, counts);
+
+        std::vector<double> result;
+        RecurrenceMicrostates::normalize_counts(settings, counts, counter, result);
+
+        const auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        distinct = keys.size();
+        return elapsed;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+}
+//      -------------------------------------------------------------------------------------------------------
+int main(const int argc, char **argv) {
+    const size_t samples = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    const unsigned int threads = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : 4;
+    const size_t maximum = argc > 3 ? std::stoull(argv[3]) : 27;
+
+    std::printf("hypervolume,samples,threads,distinct,dense_ms,dict_ms\n");
+
+    size_t crossover = 0;
+    for (size_t hypervolume = 16; hypervolume <= maximum; hypervolume++) {
+        const auto input = microstates(hypervolume, samples);
+
+        size_t distinct_dense = 0;
+        size_t distinct_dict = 0;
+        const auto time_dense = dense(input, hypervolume, threads, distinct_dense);
+        const auto time_dict = hashed(input, hypervolume, threads, distinct_dict);
+
+        if (distinct_dense != distinct_dict) {
+            std::fprintf(stderr, "[ERROR] the two histograms do not agree at hypervolume %zu.\n", hypervolume);
+            return 1;
+        }
+
+        std::printf("%zu,%zu,%u,%zu,%.3f,%.3f\n", hypervolume, samples, threads, distinct_dict, time_dense, time_dict);
+        if (crossover == 0 && time_dict < time_dense) crossover = hypervolume;
+    }
+
+    std::printf("# the dictionary mode is faster from hypervolume %zu\n", crossover);
+    return 0;
+}
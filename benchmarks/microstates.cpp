@@ -0,0 +1,228 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Benchmark: microstates counting
+//      -------------------------------------------------------------------------------------------------------
+//          It runs the counting path of Probabilities (the sampler, the recurrence kernels and the histograms of
+//  counting.h) without Python, over fixed-seed synthetic series: white noise, the logistic map (r = 4) and the
+//  Lorenz system (3-D vectors). The sweep covers square structures from 2 x 2 to 5 x 5, thread counts, sample
+//  rates, the exhaustive scan of the whole plot (method = exhaustive, sample rate 1) and the dense vs. dictionary
+//  modes. Each line of the CSV output is the best of the repetitions:
+//
+//          samples_per_s       samples (microstates) counted per second of wall time;
+//          ns_per_microstate   wall time per microstate, times the threads (the cost of one on one core);
+//          peak_rss_kb         peak resident memory of the run (of the process so far, when it cannot be reset).
+//
+//      The distinct column is a checksum, it must not change between versions for the same arguments.
+//
+//      Build and run with CMake from the repository root:
+//          cmake -S benchmarks -B build-benchmarks && cmake --build build-benchmarks
+//          ./build-benchmarks/microstates [length = 2000] [maximum threads = hardware] [repetitions = 3]
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <sys/resource.h>
+//                * Include the internal headers
+#include "settings.h"
+#include "stencil.h"
+#include "sampler.h"
+#include "counting.h"
+#include "scan.h"
+#include "recurrence.h"
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint64_t seed = 2025;
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A synthetic series stored as a Tensor does it: the vector dimension first, then the time.
+    struct Series {
+        std::string name;
+        size_t length;
+        double threshold;
+        std::vector<double> data;
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    Series white_noise(const size_t size) {
+        std::mt19937_64 gen(seed);
+        std::normal_distribution<double> noise;
+
+        Series series{"white_noise", 1, 0.5, std::vector<double>(size)};
+        for (auto &v : series.data) v = noise(gen);
+        return series;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    Series logistic_map(const size_t size) {
+        Series series{"logistic_map", 1, 0.1, std::vector<double>(size)};
+
+        double x = 0.4;
+        for (size_t i = 0; i < 1000; i++) x = 4.0 * x * (1.0 - x);
+        for (auto &v : series.data) v = x = 4.0 * x * (1.0 - x);
+        return series;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    Series lorenz(const size_t size) {
+        constexpr double sigma = 10.0, rho = 28.0, beta = 8.0 / 3.0, dt = 0.01;
+
+        const auto field = [&](const double *u, double *du) {
+            du[0] = sigma * (u[1] - u[0]);
+            du[1] = u[0] * (rho - u[2]) - u[1];
+            du[2] = u[0] * u[1] - beta * u[2];
+        };
+
+        //      Fourth order Runge-Kutta, the first 1000 steps are the transient.
+        double u[3] = {1.0, 1.0, 1.0};
+        const auto step = [&] {
+            double k1[3], k2[3], k3[3], k4[3], v[3];
+            field(u, k1);
+            for (int i = 0; i < 3; i++) v[i] = u[i] + 0.5 * dt * k1[i];
+            field(v, k2);
+            for (int i = 0; i < 3; i++) v[i] = u[i] + 0.5 * dt * k2[i];
+            field(v, k3);
+            for (int i = 0; i < 3; i++) v[i] = u[i] + dt * k3[i];
+            field(v, k4);
+            for (int i = 0; i < 3; i++) u[i] += dt / 6.0 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+        };
+
+        Series series{"lorenz", 3, 5.0, std::vector<double>(3 * size)};
+        for (size_t i = 0; i < 1000; i++) step();
+        for (size_t t = 0; t < size; t++) {
+            step();
+            for (int i = 0; i < 3; i++) series.data[3 * t + i] = u[i];
+        }
+        return series;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Peak resident memory in kB. Writing 5 to clear_refs resets it on Linux, so each run has its own.
+    bool reset_peak() {
+        std::ofstream file("/proc/self/clear_refs");
+        return static_cast<bool>(file << "5");
+    }
+
+    long peak_rss() {
+        std::ifstream file("/proc/self/status");
+        for (std::string line; std::getline(file, line);)
+            if (line.rfind("VmHWM:", 0) == 0) return std::stol(line.substr(6));
+
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    struct Run {
+        double seconds = 0.0;
+        size_t samples = 0;
+        size_t distinct = 0;
+        long rss = 0;
+        bool specialized = false;
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the microstates of a series with the structure side x side, as Probabilities does.
+    Run run(const Series &series, const size_t size, const size_t side, const unsigned int threads, const double sample_rate,
+        const bool exhaustive, const unsigned short mode) {
+
+        const RecurrenceMicrostates::Settings settings({side, side}, threads, mode);
+        const std::vector<std::ptrdiff_t> strides{1, static_cast<std::ptrdiff_t>(series.length)};
+        const RecurrenceMicrostates::Stencil stencil(settings, strides, strides, series.length);
+        const RecurrenceMicrostates::Sampler sampler(settings, {series.length, size}, {series.length, size}, sample_rate, seed);
+        const RecurrenceMicrostates::Recurrence recurrence(METRIC_EUCLIDEAN, series.threshold, series.length, settings.specialization());
+
+        const RecurrenceMicrostates::Scan scan(settings, series.data.data(), {series.length, size}, strides, series.data.data(),
+            {series.length, size}, strides, recurrence);
+
+        const auto task = [&](const size_t begin, const size_t end, auto &&count) {
+            if (exhaustive) return scan(begin, end, count);
+            return RecurrenceMicrostates::count_microstates(sampler, begin, end, stencil, series.data.data(), series.data.data(),
+                recurrence, count);
+        };
+        const auto tasks = exhaustive ? scan.rows() : sampler.size();
+        const auto chunk = exhaustive ? SCAN_CHUNK : DEFAULT_CHUNK;
+
+        Run result;
+        result.samples = exhaustive ? scan.size() : sampler.size();
+        result.specialized = recurrence.specialized() && !exhaustive;
+
+        std::vector<double> probabilities;
+        std::vector<uint64_t> keys;
+        std::vector<size_t> counts;
+
+        const auto start = Clock::now();
+        if (settings.dictionary())
+            RecurrenceMicrostates::histogram_sparse(settings, tasks, chunk, task, keys, counts, probabilities);
+        else
+            RecurrenceMicrostates::histogram_dense(settings, tasks, chunk, task, probabilities);
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        result.distinct = static_cast<size_t>(std::ranges::count_if(probabilities, [](const double p) { return p > 0; }));
+        result.rss = peak_rss();
+        return result;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+}
+//      -------------------------------------------------------------------------------------------------------
+int main(const int argc, char **argv) {
+    const size_t size = argc > 1 ? std::stoull(argv[1]) : 2000;
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int maximum = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : hardware;
+    const int repetitions = argc > 3 ? std::stoi(argv[3]) : 3;
+
+    std::vector<unsigned int> threads;
+    for (unsigned int t = 1; t < maximum; t *= 2) threads.push_back(t);
+    threads.push_back(maximum);
+
+    const std::vector<double> rates{0.05, 0.2, 1.0};
+    const std::vector<size_t> sides{2, 3, 4, 5};
+    const std::vector series{white_noise(size), logistic_map(size), lorenz(size)};
+
+    std::printf("data,structure,hypervolume,specialized,threads,sample_rate,method,mode,samples,distinct,seconds,samples_per_s,ns_per_microstate,peak_rss_kb\n");
+
+    for (const auto &s : series)
+        for (const auto side : sides)
+            for (const auto mode : {MODE_FORCE_VECTOR, MODE_FORCE_DICTIONARY}) {
+                //      The dense vectors need threads * 8 * 2^hypervolume bytes, they stop where the default does.
+                const auto hypervolume = side * side;
+                if (mode == MODE_FORCE_VECTOR && hypervolume > DEFAULT_HYPERVOLUME_TO_DICTIONARY + 1) continue;
+
+                for (const auto t : threads)
+                    for (const auto rate : rates) {
+                        //      The sample rate 1 is the exhaustive scan, the only way to take every microstate.
+                        const auto exhaustive = rate >= 1.0;
+
+                        Run best;
+                        for (int r = 0; r < repetitions; r++) {
+                            const auto reset = reset_peak();
+                            const auto current = run(s, size, side, t, rate, exhaustive, static_cast<unsigned short>(mode));
+                            if (r == 0 || current.seconds < best.seconds) best = current;
+                            if (!reset) best.rss = current.rss;
+                        }
+
+                        const auto per_second = static_cast<double>(best.samples) / best.seconds;
+                        const auto per_microstate = best.seconds * 1e9 * t / static_cast<double>(best.samples);
+
+                        std::printf("%s,%zux%zu,%zu,%d,%u,%.3f,%s,%s,%zu,%zu,%.6f,%.0f,%.2f,%ld\n", s.name.c_str(), side, side,
+                            hypervolume, best.specialized ? 1 : 0, t, rate, exhaustive ? "exhaustive" : "sampled", mode == MODE_FORCE_VECTOR ? "dense" : "dictionary",
+                            best.samples, best.distinct, best.seconds, per_second, per_microstate, best.rss);
+                        std::fflush(stdout);
+                    }
+            }
+
+    return 0;
+}
@@ -17,7 +17,7 @@ from setuptools import setup, Extension
 ext_modules = [
     Extension(
         "microrecpy",
-        ["src/module.cpp", "src/settings.cpp", "src/tensor.cpp", "src/probabilities.cpp"],
+        ["src/module.cpp", "src/settings.cpp", "src/tensor.cpp", "src/stencil.cpp", "src/sampler.cpp", "src/scan.cpp", "src/spatial.cpp", "src/matrix.cpp", "src/mapped.cpp", "src/batch.cpp", "src/recurrence.cpp", "src/kernels.cpp", "src/histogram.cpp", "src/convergence.cpp", "src/record.cpp", "src/profiler.cpp", "src/threadpool.cpp", "src/probabilities.cpp", "src/sweep.cpp", "src/stream.cpp"],
         include_dirs=[pybind11.get_include()],
         language="c++",
         extra_compile_args=["-std=c++23"]
@@ -0,0 +1,48 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          The NumPy arrays that give the results to Python without copying them.
+//      -------------------------------------------------------------------------------------------------------
+#ifndef ARRAYS_H
+#define ARRAYS_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <vector>
+#include <utility>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A read-only array over a buffer of an object created by Python. The array holds a reference
+    //  to the object, so the buffer lives as long as any array over it. The shape is the size of the buffer when
+    //  none is given.
+    template<typename T, typename Owner> pybind11::array_t<T> view_array(const Owner *owner, const std::vector<T> &values,
+        std::vector<pybind11::ssize_t> shape = {}) {
+
+        if (shape.empty()) shape.push_back(static_cast<pybind11::ssize_t>(values.size()));
+
+        pybind11::array_t<T> array(shape, values.data(), pybind11::cast(owner, pybind11::return_value_policy::reference));
+        array.attr("setflags")(pybind11::arg("write") = false);
+        return array;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * An array that takes the buffer of a vector, which is deleted with the array.
+    template<typename T> pybind11::array_t<T> take_array(std::vector<T> &&values) {
+        auto *owner = new std::vector<T>(std::move(values));
+        const pybind11::capsule base(owner, [](void *ptr) { delete static_cast<std::vector<T> *>(ptr); });
+
+        return pybind11::array_t<T>(static_cast<pybind11::ssize_t>(owner->size()), owner->data(), base);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
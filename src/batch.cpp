@@ -0,0 +1,119 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Batch .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "batch.h"
+//                * Include the used libraries.
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+
+#include "scan.h"
+#include "stencil.h"
+#include "sampler.h"
+#include "counting.h"
+#include "recurrence.h"
+#include "threadpool.h"
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    using namespace RecurrenceMicrostates;
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Everything needed to count the microstates of one series, as Probabilities does.
+    class SeriesJob {
+        const double *data;
+        Stencil stencil;
+        Sampler sampler;
+        Recurrence recurrence;
+        std::optional<Scan> scan;
+
+    public:
+        [[nodiscard]] size_t tasks() const { return scan ? scan->rows() : sampler.size(); }
+        [[nodiscard]] size_t chunk() const { return scan ? SCAN_CHUNK : DEFAULT_CHUNK; }
+
+        template<typename Counter> size_t operator()(const size_t begin, const size_t end, Counter &&count) const {
+            if (scan) return (*scan)(begin, end, count);
+            return count_microstates(sampler, begin, end, stencil, data, data, recurrence, count);
+        }
+
+        SeriesJob(const Settings &settings, const SeriesView &view, const unsigned short metric, const double threshold,
+            const double sample_rate, const uint64_t seed, const bool exhaustive) : data(view.data),
+            stencil(settings, view.strides, view.strides, view.dims[0]),
+            sampler(settings, view.dims, view.dims, sample_rate, seed),
+            recurrence(metric, threshold, view.dims[0], settings.specialization()) {
+
+            if (exhaustive) scan.emplace(settings, data, view.dims, view.strides, data, view.dims, view.strides, recurrence);
+        }
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    void normalize(const std::vector<size_t> &histogram, const size_t counter, double *row) {
+        const auto total = counter > 0 ? static_cast<double>(counter) : 1.0;
+        for (size_t i = 0; i < histogram.size(); i++) row[i] = static_cast<double>(histogram[i]) / total;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::check_batch(const Settings &settings, const std::vector<SeriesView> &series) {
+    if (settings.dictionary() || settings.get_hypervolume() >= 64)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Batch: the batch output is dense, the structure must be in the vector mode.");
+    if (settings.dimensions() != 2)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Batch: the batch requires time series, with a two dimensional structure.");
+    for (const auto &view : series)
+        if (view.dims.size() != 2 || view.dims[1] < std::max(settings.patch_x(), settings.patch_y()))
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - Batch: each series must be a time series longer than the microstate structure.");
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::count_batch(const Settings &settings, const std::vector<SeriesView> &series, const unsigned short metric,
+    const double threshold, const double sample_rate, const uint64_t seed, const bool exhaustive, double *output) {
+
+    //      Check the input before to do anything.
+    check_batch(settings, series);
+
+    const auto possibilities = settings.possibilities();
+    const auto workers = settings.available_threads();
+    auto &pool = settings.pool();
+
+    //      Split the series by the number of microstates that they give.
+    std::vector<size_t> short_series;
+    std::vector<size_t> long_series;
+    for (size_t s = 0; s < series.size(); s++) {
+        const auto points = static_cast<double>(series[s].dims[1]) * static_cast<double>(series[s].dims[1]);
+        const auto microstates = exhaustive ? points : points * sample_rate;
+        (microstates < BATCH_LONG_SERIES ? short_series : long_series).push_back(s);
+    }
+
+    //      The short series go whole to the threads, each one counting into its own histogram.
+    std::vector<Padded<std::vector<size_t>>> histograms(workers);
+    pool.parallel_for(short_series.size(), workers, 1, [&](const unsigned int worker, const size_t begin, const size_t end) {
+        auto &histogram = histograms[worker].value;
+
+        for (auto k = begin; k < end; k++) {
+            const auto s = short_series[k];
+            const SeriesJob job(settings, series[s], metric, threshold, sample_rate, seed + s, exhaustive);
+
+            histogram.assign(possibilities, 0);
+            const auto counter = job(0, job.tasks(), [&](const uint64_t microstate) { histogram[microstate]++; });
+            normalize(histogram, counter, output + s * possibilities);
+        }
+    });
+
+    //      The long series are split between all the threads, as in Probabilities.
+    std::vector<double> result;
+    for (const auto s : long_series) {
+        const SeriesJob job(settings, series[s], metric, threshold, sample_rate, seed + s, exhaustive);
+        histogram_dense(settings, job.tasks(), job.chunk(), job, result);
+        std::ranges::copy(result, output + s * possibilities);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,50 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Batch header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef BATCH_H
+#define BATCH_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "settings.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define BATCH_LONG_SERIES 1048576     //  Microstates from which a series is split between the threads by itself.
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A time series of a batch, with its dimensions and strides as a Tensor stores them: the first
+    //  (vector) dimension and the time.
+    struct SeriesView {
+        const double *data;
+        std::vector<size_t> dims;
+        std::vector<std::ptrdiff_t> strides;
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Check that a batch can be counted into a dense (series, settings.possibilities()) output, before
+    //  the output is allocated.
+    void check_batch(const Settings &settings, const std::vector<SeriesView> &series);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Compute the microstates probabilities of the recurrence plot of each series with itself.
+    //      The row s of output, with settings.possibilities() values, gets the probabilities of the series s. The short
+    //  series are shared between the threads, one whole series for each, and the long ones are computed one at a
+    //  time with all the threads. The series s is sampled with the seed seed + s.
+    void count_batch(const Settings &settings, const std::vector<SeriesView> &series, unsigned short metric, double threshold,
+        double sample_rate, uint64_t seed, bool exhaustive, double *output);
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
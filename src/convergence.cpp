@@ -0,0 +1,91 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Convergence .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "convergence.h"
+//                * Include the used libraries.
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+//      -------------------------------------------------------------------------------------------------------
+unsigned short RecurrenceMicrostates::criterion_from_name(const std::string &name) {
+    if (name == "entropy") return CRITERION_ENTROPY;
+    if (name == "max") return CRITERION_MAX;
+
+    throw std::invalid_argument("[ERROR] Recurrence Microstates - Convergence: unknown criterion '" + name + "', use 'entropy' or 'max'.");
+}
+//      -------------------------------------------------------------------------------------------------------
+bool RecurrenceMicrostates::Convergence::update(const double change) {
+    //      The first round has nothing to be compared with.
+    this->last = this->first ? std::numeric_limits<double>::infinity() : change;
+    this->first = false;
+    return this->last < this->tolerance;
+}
+//      -------------------------------------------------------------------------------------------------------
+bool RecurrenceMicrostates::Convergence::operator()(const std::vector<size_t> &counts, const size_t total) {
+    const auto n = total > 0 ? static_cast<double>(total) : 1.0;
+
+    if (criterion == CRITERION_ENTROPY) {
+        double value = 0.0;
+        for (const auto count : counts)
+            if (count > 0) value -= static_cast<double>(count) / n * std::log(static_cast<double>(count) / n);
+
+        const auto change = std::abs(value - entropy);
+        entropy = value;
+        return update(change);
+    }
+
+    previous.resize(counts.size(), 0.0);
+    double change = 0.0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        const auto p = static_cast<double>(counts[i]) / n;
+        change = std::max(change, std::abs(p - previous[i]));
+        previous[i] = p;
+    }
+
+    return update(change);
+}
+//      -------------------------------------------------------------------------------------------------------
+bool RecurrenceMicrostates::Convergence::operator()(const std::vector<uint64_t> &keys, const std::vector<size_t> &counts, const size_t total) {
+    const auto n = total > 0 ? static_cast<double>(total) : 1.0;
+
+    if (criterion == CRITERION_ENTROPY) return (*this)(counts, total);
+
+    //      Walk the old and the new keys together, a microstate missing on one side has probability zero there.
+    std::vector<double> current(counts.size());
+    double change = 0.0;
+    size_t a = 0;
+    for (size_t b = 0; b < keys.size(); b++) {
+        for (; a < this->keys.size() && this->keys[a] < keys[b]; a++) change = std::max(change, previous[a]);
+
+        current[b] = static_cast<double>(counts[b]) / n;
+        const auto before = a < this->keys.size() && this->keys[a] == keys[b] ? previous[a++] : 0.0;
+        change = std::max(change, std::abs(current[b] - before));
+    }
+    for (; a < this->keys.size(); a++) change = std::max(change, previous[a]);
+
+    this->keys = keys;
+    this->previous = std::move(current);
+    return update(change);
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Convergence::Convergence(const unsigned short criterion, const double tolerance)
+    : criterion(criterion), tolerance(tolerance) {
+    if (!(tolerance > 0))
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Convergence: the tolerance must be positive.");
+}
+//      -------------------------------------------------------------------------------------------------------
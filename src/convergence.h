@@ -0,0 +1,66 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Convergence header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef CONVERGENCE_H
+#define CONVERGENCE_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define CRITERION_ENTROPY 0         //  Change of the Shannon entropy (in nats).
+#define CRITERION_MAX 1             //  Largest change of the probability of a microstate.
+
+#define DEFAULT_CRITERION "entropy"
+#define ADAPTIVE_MIN_SAMPLES 65536  //  Samples of the first round, the adaptive mode never stops before twice this.
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Convert a criterion name ("entropy" or "max") to its define.
+    unsigned short criterion_from_name(const std::string &name);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Convergence class structure.
+    //      It follows the distribution of an adaptive run between its rounds: each call gives the histogram after
+    //  one more round and tells if it moved less than the tolerance since the previous call.
+    class Convergence {
+        unsigned short criterion;
+        double tolerance;
+
+        bool first = true;
+        double entropy = 0.0;
+        double last = std::numeric_limits<double>::infinity();
+
+        //      The previous probabilities, only kept for the max criterion (dense, or following keys).
+        std::vector<uint64_t> keys;
+        std::vector<double> previous;
+
+        bool update(double change);
+
+    public:
+        [[nodiscard]] double change() const { return last; }
+
+        //      Dense histogram, indexed by the microstate.
+        bool operator()(const std::vector<size_t> &counts, size_t total);
+        //      Sparse histogram, with the keys in ascending order.
+        bool operator()(const std::vector<uint64_t> &keys, const std::vector<size_t> &counts, size_t total);
+
+        Convergence(unsigned short criterion, double tolerance);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
@@ -0,0 +1,292 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Counting header
+//      -------------------------------------------------------------------------------------------------------
+//          The counting loops shared by Probabilities and the native benchmarks. They only see raw pointers, so
+//  they are free of Python and the benchmarks measure exactly the code that the library runs.
+//      -------------------------------------------------------------------------------------------------------
+#ifndef COUNTING_H
+#define COUNTING_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "settings.h"
+#include "stencil.h"
+#include "sampler.h"
+#include "recurrence.h"
+#include "matrix.h"
+#include "histogram.h"
+#include "threadpool.h"
+#include "profiler.h"
+#include "convergence.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the microstates of the samples [begin, end) with a built-in recurrence.
+    //      The whole microstate is evaluated in a single kernel call: the one specialized for the shape when there
+    //  is one, otherwise the vectorized stencil kernel. It returns the number of samples counted.
+    template<typename T, typename Counter> size_t count_microstates(const Sampler &sampler, const size_t begin, const size_t end,
+        const Stencil &stencil, const T *data_x, const T *data_y, const BasicRecurrence<T> &recurrence, Counter &&count) {
+
+        const auto cells = stencil.cells();
+        const auto step_x = stencil.step_x();
+        const auto step_y = stencil.step_y();
+
+        //      The samples are drawn on demand into a single buffer for the whole task, with the tile of the last one.
+        std::vector<size_t> sample(sampler.dimensions());
+        auto cursor = sampler.cursor();
+
+        if (recurrence.specialized()) {
+            const auto *patch_x = stencil.patch_x();
+            const auto *patch_y = stencil.patch_y();
+
+            for (auto s = begin; s < end; s++) {
+                sampler(s, sample.data(), cursor);
+                const auto *base_x = data_x + stencil.base_x(sample.data());
+                const auto *base_y = data_y + stencil.base_y(sample.data());
+
+                count(recurrence.microstate(base_x, patch_x, step_x, base_y, patch_y, step_y));
+            }
+        } else {
+            const auto *offsets_x = stencil.offsets_x();
+            const auto *offsets_y = stencil.offsets_y();
+
+            for (auto s = begin; s < end; s++) {
+                sampler(s, sample.data(), cursor);
+                const auto *base_x = data_x + stencil.base_x(sample.data());
+                const auto *base_y = data_y + stencil.base_y(sample.data());
+
+                count(recurrence(base_x, offsets_x, step_x, base_y, offsets_y, step_y, cells));
+            }
+        }
+
+        return end - begin;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the microstates of the samples [begin, end) from a recurrence matrix, for a time series
+    //  structure patch_x x patch_y. It returns the number of samples counted.
+    template<typename Counter> size_t count_microstates(const Sampler &sampler, const size_t begin, const size_t end,
+        const RecurrenceMatrix &matrix, const size_t patch_x, const size_t patch_y, Counter &&count) {
+
+        size_t sample[2];
+        auto cursor = sampler.cursor();
+        for (auto s = begin; s < end; s++) {
+            sampler(s, sample, cursor);
+            count(matrix.microstate(sample[0], sample[1], patch_x, patch_y));
+        }
+
+        return end - begin;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count every microstate of the rows [begin, end) of a recurrence matrix.
+    template<typename Counter> size_t scan_microstates(const size_t begin, const size_t end, const RecurrenceMatrix &matrix,
+        const size_t patch_x, const size_t patch_y, Counter &&count) {
+
+        const auto columns = matrix.columns() - patch_x + 1;
+        for (auto j = begin; j < end; j++)
+            for (size_t i = 0; i < columns; i++) count(matrix.microstate(i, j, patch_x, patch_y));
+
+        return (end - begin) * columns;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the samples [0, samples) into a dense histogram of bins entries, adding them to counts.
+    //      task(begin, end, count) counts a chunk of samples calling count(bin), and returns how many samples it
+    //  counted. Each thread of the pool keeps its own histogram, then they are summed in parallel. It returns the
+    //  number of samples counted. With a profiler, each chunk is timed and counted for its worker.
+    template<typename Task> size_t count_bins(const Settings &settings, const size_t bins, const size_t samples, const size_t chunk,
+        Task &&task, std::vector<size_t> &counts, Profiler *profiler = nullptr) {
+
+        const auto workers = settings.available_threads();
+        auto &pool = settings.pool();
+
+        std::vector<Padded<std::vector<size_t>>> partials(workers);
+        {
+            ProfilePhase phase(profiler, PHASE_COUNT);
+            pool.parallel_for(samples, workers, chunk, [&](const unsigned int worker, const size_t begin, const size_t end) {
+                auto &partial = partials[worker];
+                if (partial.value.empty()) partial.value.assign(bins, 0);
+
+                const auto start = profiler != nullptr ? profiler->enter(worker) : 0.0;
+                const auto counted = task(begin, end, [&](const uint64_t bin) { partial.value[bin]++; });
+                partial.counter += counted;
+                if (profiler != nullptr) profiler->record(worker, PHASE_COUNT, start, counted);
+            });
+        }
+
+        size_t counter = 0;
+        for (const auto &partial : partials) counter += partial.counter;
+
+        //      Parallel reduction: each chunk of microstates is summed over all the histograms.
+        ProfilePhase phase(profiler, PHASE_REDUCE);
+        counts.resize(bins, 0);
+        pool.parallel_for(bins, workers, DEFAULT_CHUNK * 16, [&](const unsigned int worker, const size_t begin, const size_t end) {
+            const auto start = profiler != nullptr ? profiler->enter(worker) : 0.0;
+            for (auto i = begin; i < end; i++) {
+                auto sum = counts[i];
+                for (const auto &partial : partials)
+                    if (!partial.value.empty()) sum += partial.value[i];
+
+                counts[i] = sum;
+            }
+            if (profiler != nullptr) profiler->record(worker, PHASE_REDUCE, start);
+        });
+
+        return counter;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the samples [0, samples) into a dense histogram of all the microstates, adding them to counts.
+    template<typename Task> size_t count_dense(const Settings &settings, const size_t samples, const size_t chunk, Task &&task,
+        std::vector<size_t> &counts, Profiler *profiler = nullptr) {
+        return count_bins(settings, settings.possibilities(), samples, chunk, std::forward<Task>(task), counts, profiler);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the samples [0, samples) into hash histograms, adding them to histogram.
+    //      The memory is bounded by the microstates that really occur. The histograms of the threads are merged
+    //  by a parallel tree reduction into the first one. It returns the number of samples counted.
+    template<typename Task> size_t count_sparse(const Settings &settings, const size_t samples, const size_t chunk, Task &&task,
+        FlatHistogram &histogram, Profiler *profiler = nullptr) {
+
+        const auto workers = settings.available_threads();
+        auto &pool = settings.pool();
+
+        std::vector<Padded<FlatHistogram>> partials(workers);
+        {
+            ProfilePhase phase(profiler, PHASE_COUNT);
+            pool.parallel_for(samples, workers, chunk, [&](const unsigned int worker, const size_t begin, const size_t end) {
+                auto &partial = partials[worker];
+
+                const auto start = profiler != nullptr ? profiler->enter(worker) : 0.0;
+                const auto counted = task(begin, end, [&](const uint64_t microstate) { partial.value.add(microstate); });
+                partial.counter += counted;
+                if (profiler != nullptr) profiler->record(worker, PHASE_COUNT, start, counted);
+            });
+        }
+
+        size_t counter = 0;
+        for (const auto &partial : partials) counter += partial.counter;
+
+        ProfilePhase phase(profiler, PHASE_REDUCE);
+        for (unsigned int step = 1; step < workers; step *= 2)
+            pool.run(workers, [&](const unsigned int worker) {
+                if (worker % (2 * step) == 0 && worker + step < workers) {
+                    const auto start = profiler != nullptr ? profiler->enter(worker) : 0.0;
+                    partials[worker].value.merge(partials[worker + step].value);
+                    if (profiler != nullptr) profiler->record(worker, PHASE_REDUCE, start);
+                }
+            });
+
+        if (histogram.size() == 0) std::swap(histogram, partials[0].value);
+        else histogram.merge(partials[0].value);
+
+        return counter;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Divide the counts by the number of samples, in parallel.
+    inline void normalize_counts(const Settings &settings, const std::vector<size_t> &counts, const size_t counter, std::vector<double> &result,
+        Profiler *profiler = nullptr) {
+        const auto total = counter > 0 ? static_cast<double>(counter) : 1.0;
+
+        ProfilePhase phase(profiler, PHASE_NORMALIZE);
+        result.resize(counts.size());
+        settings.pool().parallel_for(counts.size(), settings.available_threads(), DEFAULT_CHUNK * 16,
+            [&](unsigned int, const size_t begin, const size_t end) {
+                for (auto i = begin; i < end; i++) result[i] = static_cast<double>(counts[i]) / total;
+            });
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The task over [0, samples) in an order whose every prefix is spread over the whole range.
+    //      In the tiled order a prefix of the samples is only the first tiles. Here the chunks are permuted by a
+    //  Weyl sequence, c -> c * step mod chunks with step coprime to chunks and near chunks / golden ratio, so the
+    //  first n chunks are about evenly spaced, and the samples of a chunk stay together (one tile). The last
+    //  partial chunk keeps its place. Over the whole range it is the same set of samples.
+    template<typename Task> auto spread_task(const size_t samples, const size_t chunk, Task &task) {
+        const auto chunks = samples / chunk;
+        auto step = static_cast<size_t>(static_cast<double>(chunks) * 0.6180339887498949) | 1;
+        while (chunks > 1 && std::gcd(step, chunks) != 1) step++;
+
+        return [&task, chunk, chunks, step](const size_t begin, const size_t end, auto &&add) {
+            size_t counted = 0;
+            for (auto j = begin; j < end;) {
+                const auto c = j / chunk;
+                const auto length = std::min(end - j, chunk - j % chunk);
+                const auto i = c < chunks ? static_cast<size_t>(static_cast<unsigned __int128>(c) * step % chunks) * chunk + j % chunk : j;
+
+                counted += task(i, i + length, add);
+                j += length;
+            }
+            return counted;
+        };
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the samples [0, samples) in rounds until the distribution converges.
+    //      The first round takes min_samples and each next one doubles the total, and after each round the
+    //  convergence is checked. The counts are dense, or sparse following keys in the dictionary mode. It returns
+    //  the number of samples counted and sets stopped when it converged before the end.
+    template<typename Task> size_t count_adaptive(const Settings &settings, const size_t samples, const size_t chunk, Task &&task,
+        Convergence &convergence, const size_t min_samples, std::vector<uint64_t> &keys, std::vector<size_t> &counts, bool &stopped,
+        Profiler *profiler = nullptr) {
+
+        FlatHistogram sparse;
+        size_t counter = 0;
+        size_t done = 0;
+        size_t round = std::max<size_t>(1, min_samples);
+
+        stopped = false;
+        while (done < samples && !stopped) {
+            const auto first = done;
+            done = std::min(samples, done + round);
+            round = done;
+
+            const auto shifted = [&](const size_t begin, const size_t end, auto &&add) { return task(first + begin, first + end, add); };
+            if (settings.dictionary()) {
+                counter += count_sparse(settings, done - first, chunk, shifted, sparse, profiler);
+                sparse.sorted(keys, counts);
+                stopped = convergence(keys, counts, counter);
+            } else {
+                counter += count_dense(settings, done - first, chunk, shifted, counts, profiler);
+                stopped = convergence(counts, counter);
+            }
+        }
+
+        return counter;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the samples [0, samples) into the probabilities of all the microstates.
+    template<typename Task> size_t histogram_dense(const Settings &settings, const size_t samples, const size_t chunk, Task &&task,
+        std::vector<double> &result) {
+
+        std::vector<size_t> counts;
+        const auto counter = count_dense(settings, samples, chunk, task, counts);
+        normalize_counts(settings, counts, counter, result);
+        return counter;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Count the samples [0, samples) into the sorted keys, their counts and their probabilities.
+    template<typename Task> size_t histogram_sparse(const Settings &settings, const size_t samples, const size_t chunk, Task &&task,
+        std::vector<uint64_t> &keys, std::vector<size_t> &counts, std::vector<double> &result) {
+
+        FlatHistogram histogram;
+        const auto counter = count_sparse(settings, samples, chunk, task, histogram);
+        histogram.sorted(keys, counts);
+        normalize_counts(settings, counts, counter, result);
+        return counter;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
@@ -0,0 +1,106 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Histogram .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "histogram.h"
+//                * Include the used libraries.
+#include <bit>
+#include <vector>
+#include <utility>
+#include <algorithm>
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::FlatHistogram::FlatHistogram(const size_t capacity) {
+    const auto size = std::bit_ceil(std::max(capacity, size_t{2}));
+    slots.assign(size, Slot{0, 0});
+    shift = 64 - std::countr_zero(size);
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::FlatHistogram::grow() {
+    reserve(slots.size());
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::FlatHistogram::reserve(const size_t microstates) {
+    const auto size = std::bit_ceil(std::max(2 * microstates, size_t{2}));
+    if (size <= slots.size()) return;
+
+    auto old = std::move(slots);
+
+    slots.assign(size, Slot{0, 0});
+    shift = 64 - std::countr_zero(size);
+    used = 0;
+
+    for (const auto &slot : old)
+        if (slot.count > 0) add(slot.key, slot.count);
+}
+//      -------------------------------------------------------------------------------------------------------
+size_t RecurrenceMicrostates::FlatHistogram::count(const uint64_t key) const {
+    const auto mask = slots.size() - 1;
+    for (auto i = index(key);; i = (i + 1) & mask) {
+        const auto &slot = slots[i];
+        if (slot.count == 0) return 0;
+        if (slot.key == key) return slot.count;
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::FlatHistogram::remove(const uint64_t key, const size_t count) {
+    const auto mask = slots.size() - 1;
+
+    auto hole = index(key);
+    for (;; hole = (hole + 1) & mask) {
+        if (slots[hole].count == 0) return;
+        if (slots[hole].key == key) break;
+    }
+
+    if (slots[hole].count > count) {
+        slots[hole].count -= count;
+        return;
+    }
+
+    //      Backward shift deletion: the entries after the hole that may live there move back, so every probe
+    //  chain stays without gaps and no tombstone is needed.
+    --used;
+    for (auto i = (hole + 1) & mask; slots[i].count != 0; i = (i + 1) & mask) {
+        const auto home = index(slots[i].key);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole] = Slot{0, 0};
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::FlatHistogram::merge(const FlatHistogram &other) {
+    //      The slots of other come in hash order, inserting them in a smaller table would pile them up in
+    //  its first slots. With at least the same capacity they land spread as they were.
+    reserve(std::max(used + other.used, other.slots.size() / 2));
+
+    for (const auto &slot : other.slots)
+        if (slot.count > 0) add(slot.key, slot.count);
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::FlatHistogram::sorted(std::vector<uint64_t> &keys, std::vector<size_t> &counts) const {
+    std::vector<Slot> found;
+    found.reserve(used);
+    for (const auto &slot : slots)
+        if (slot.count > 0) found.push_back(slot);
+
+    std::ranges::sort(found, {}, &Slot::key);
+
+    keys.resize(found.size());
+    counts.resize(found.size());
+    for (size_t i = 0; i < found.size(); i++) {
+        keys[i] = found[i].key;
+        counts[i] = found[i].count;
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
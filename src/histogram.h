@@ -0,0 +1,87 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Histogram header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define DEFAULT_HISTOGRAM_CAPACITY 1024
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our FlatHistogram class structure.
+    //      It is an open-addressing hash map (linear probing, power of two capacity) from a microstate to its count.
+    //  The memory grows with the number of distinct microstates found, not with 2^hypervolume, so it works for any
+    //  hypervolume up to 64. An empty slot is a slot with count zero, since a stored microstate always has count > 0.
+    class FlatHistogram {
+        struct Slot {
+            uint64_t key;
+            size_t count;
+        };
+
+        std::vector<Slot> slots;
+        size_t used = 0;
+        unsigned int shift;
+
+        [[nodiscard]] size_t index(const uint64_t key) const { return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift); }
+        void grow();
+
+    public:
+        [[nodiscard]] size_t size() const { return used; }
+        [[nodiscard]] size_t capacity() const { return slots.size(); }
+        [[nodiscard]] size_t count(uint64_t key) const;
+
+        //      Add some counts to a microstate.
+        void add(const uint64_t key, const size_t count = 1) {
+            if (count == 0) return;
+            if (2 * (used + 1) > slots.size()) grow();
+
+            const auto mask = slots.size() - 1;
+            for (auto i = index(key);; i = (i + 1) & mask) {
+                auto &slot = slots[i];
+                if (slot.count == 0) {
+                    slot.key = key;
+                    slot.count = count;
+                    ++used;
+                    return;
+                }
+                if (slot.key == key) {
+                    slot.count += count;
+                    return;
+                }
+            }
+        }
+
+        //      Take some counts from a microstate, it is removed when its count reaches zero.
+        void remove(uint64_t key, size_t count = 1);
+
+        //      Make room for the given number of microstates without growing again.
+        void reserve(size_t microstates);
+
+        //      Add all the counts of another histogram to this one.
+        void merge(const FlatHistogram &other);
+
+        //      Export the microstates in ascending order, with their counts.
+        void sorted(std::vector<uint64_t> &keys, std::vector<size_t> &counts) const;
+
+        explicit FlatHistogram(size_t capacity = DEFAULT_HISTOGRAM_CAPACITY);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
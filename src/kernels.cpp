@@ -0,0 +1,97 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Kernels .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "kernels.h"
+//                * Include the used libraries.
+#include <cmath>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+#include "recurrence.h"
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Distance between two vectors, compared with the threshold as the Recurrence class does.
+    template<unsigned short M, size_t L> bool recurrent(const double *x, const std::ptrdiff_t step_x, const double *y,
+        const std::ptrdiff_t step_y, const size_t length, const double threshold) {
+
+        const size_t n = L == 0 ? length : L;
+        auto distance = 0.0;
+        for (size_t k = 0; k < n; k++) {
+            const auto diff = x[static_cast<std::ptrdiff_t>(k) * step_x] - y[static_cast<std::ptrdiff_t>(k) * step_y];
+
+            if constexpr (M == METRIC_EUCLIDEAN) distance += diff * diff;
+            else if constexpr (M == METRIC_CHEBYSHEV) distance = std::max(distance, std::abs(diff));
+            else distance += std::abs(diff);
+        }
+
+        return distance <= threshold;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The kernel of a shape: all the loops are unrolled at compile time, so the microstate is
+    //  assembled with constant shifts. For vectors of length one the patches are loaded only once.
+    template<size_t XV, size_t YV, unsigned short M, size_t L>
+    uint64_t shape_kernel(const double *x, const std::ptrdiff_t *patch_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *patch_y, const std::ptrdiff_t step_y, const size_t length,
+        const double threshold) {
+
+        uint64_t bits = 0;
+        if constexpr (L == 1) {
+            double a[XV];
+            double b[YV];
+
+            [&]<size_t... I>(std::index_sequence<I...>) { ((a[I] = x[patch_x[I]]), ...); }(std::make_index_sequence<XV>{});
+            [&]<size_t... I>(std::index_sequence<I...>) { ((b[I] = y[patch_y[I]]), ...); }(std::make_index_sequence<YV>{});
+
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((bits |= static_cast<uint64_t>(recurrent<M, 1>(a + I % XV, 1, b + I / XV, 1, 1, threshold)) << I), ...);
+            }(std::make_index_sequence<XV * YV>{});
+        } else {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((bits |= static_cast<uint64_t>(recurrent<M, L>(x + patch_x[I % XV], step_x, y + patch_y[I / XV], step_y,
+                    length, threshold)) << I), ...);
+            }(std::make_index_sequence<XV * YV>{});
+        }
+
+        return bits;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    template<size_t XV, size_t YV> constexpr RecurrenceMicrostates::ShapeKernels make_shape() {
+        return {XV, YV,
+            {shape_kernel<XV, YV, METRIC_EUCLIDEAN, 1>, shape_kernel<XV, YV, METRIC_CHEBYSHEV, 1>, shape_kernel<XV, YV, METRIC_MANHATTAN, 1>},
+            {shape_kernel<XV, YV, METRIC_EUCLIDEAN, 0>, shape_kernel<XV, YV, METRIC_CHEBYSHEV, 0>, shape_kernel<XV, YV, METRIC_MANHATTAN, 0>}};
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The specialized shapes, by their patches:
+    //          - 2x2, 3x3, 4x4 and 5x5 over time series;
+    //          - 2x2x2x2 (the same patches of 4x4), 3x3x2x2 and 2x2x3x3 over spatial data.
+    constexpr RecurrenceMicrostates::ShapeKernels shapes[] = {
+        make_shape<2, 2>(),
+        make_shape<3, 3>(),
+        make_shape<4, 4>(),
+        make_shape<5, 5>(),
+        make_shape<9, 4>(),
+        make_shape<4, 9>(),
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+//      -------------------------------------------------------------------------------------------------------
+const RecurrenceMicrostates::ShapeKernels *RecurrenceMicrostates::shape_kernels(const size_t patch_x, const size_t patch_y) {
+    for (const auto &shape : shapes)
+        if (shape.patch_x == patch_x && shape.patch_y == patch_y) return &shape;
+
+    return nullptr;
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,42 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Kernels header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef KERNELS_H
+#define KERNELS_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <cstdint>
+#include <cstddef>
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A microstate kernel computes a whole microstate from its two patches: the x patch has
+    //  patch_x points and the y patch has patch_y points, given as offsets from x and y. The cell (a, b) is the
+    //  bit a + patch_x * b, which is the same order of the Settings stencil.
+    using MicrostateKernel = uint64_t (*)(const double *x, const std::ptrdiff_t *patch_x, std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *patch_y, std::ptrdiff_t step_y, size_t length, double threshold);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Kernels specialized at compile time for one microstate shape.
+    struct ShapeKernels {
+        size_t patch_x;
+        size_t patch_y;
+        MicrostateKernel scalar[3];     //  Vectors of length one, indexed by the metric.
+        MicrostateKernel vector[3];     //  Vectors of any length, indexed by the metric.
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Find the specialized kernels of a shape, it returns nullptr when the shape is not specialized.
+    const ShapeKernels *shape_kernels(size_t patch_x, size_t patch_y);
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
@@ -0,0 +1,96 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Mapped file .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "mapped.h"
+//                * Include the used libraries.
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::MappedFile::MappedFile(const std::string &path) {
+    const auto descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the file '" + path + "' can not be opened.");
+
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+        close(descriptor);
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the file '" + path + "' is empty or can not be read.");
+    }
+
+    this->length = static_cast<size_t>(status.st_size);
+    this->address = mmap(nullptr, this->length, PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+
+    if (this->address == MAP_FAILED) {
+        this->address = nullptr;
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the file '" + path + "' can not be mapped.");
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::MappedFile::~MappedFile() {
+    if (this->address != nullptr) munmap(this->address, this->length);
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::NpyHeader RecurrenceMicrostates::read_npy_header(const MappedFile &file) {
+    //      The format: "\x93NUMPY", two version bytes, the header length (2 bytes in the version 1, 4 bytes after)
+    //  and a Python dict literal as {'descr': '<f8', 'fortran_order': False, 'shape': (3, 1000), }.
+    const auto *bytes = reinterpret_cast<const unsigned char *>(file.data());
+    if (file.size() < 10 || std::memcmp(bytes, "\x93NUMPY", 6) != 0)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the file is not a NumPy .npy file.");
+
+    const auto major = bytes[6];
+    const size_t prefix = major == 1 ? 10 : 12;
+    if (file.size() < prefix)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the .npy header is truncated.");
+
+    const size_t length = major == 1 ? bytes[8] | static_cast<size_t>(bytes[9]) << 8
+                                     : bytes[8] | static_cast<size_t>(bytes[9]) << 8 | static_cast<size_t>(bytes[10]) << 16 | static_cast<size_t>(bytes[11]) << 24;
+    if (file.size() < prefix + length)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the .npy header is truncated.");
+
+    const std::string text(reinterpret_cast<const char *>(bytes + prefix), length);
+    NpyHeader header;
+    header.offset = prefix + length;
+
+    //      Gets the value that follows a key of the dict, after its ':' and spaces.
+    const auto value = [&](const std::string &key) {
+        const auto at = text.find("'" + key + "'");
+        if (at == std::string::npos) throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the .npy header has no '" + key + "'.");
+        return text.find_first_not_of(" :", at + key.size() + 2);
+    };
+
+    const auto descr = value("descr");
+    header.descr = text.substr(descr + 1, text.find('\'', descr + 1) - descr - 1);
+    header.fortran_order = text.compare(value("fortran_order"), 4, "True") == 0;
+
+    const auto shape = value("shape");
+    const auto end = text.find(')', shape);
+    for (auto at = shape + 1; at < end;) {
+        at = text.find_first_of("0123456789)", at);
+        if (at >= end) break;
+
+        size_t read = 0;
+        header.shape.push_back(std::stoull(text.substr(at), &read));
+        at += read;
+    }
+
+    return header;
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,54 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Mapped file header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef MAPPED_H
+#define MAPPED_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <string>
+#include <vector>
+#include <cstddef>
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our MappedFile class structure.
+    //      A read-only memory mapping of a whole file. The data is not read when the file is opened: the pages are
+    //  brought by the OS as the samples touch them, so a series larger than the RAM can be used as input.
+    class MappedFile {
+        void *address = nullptr;
+        size_t length = 0;
+
+    public:
+        [[nodiscard]] const std::byte *data() const { return static_cast<const std::byte *>(address); }
+        [[nodiscard]] size_t size() const { return length; }
+
+        explicit MappedFile(const std::string &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The header of a NumPy .npy file: the data type, the order, the shape and where the data starts.
+    struct NpyHeader {
+        std::string descr;
+        bool fortran_order = false;
+        std::vector<size_t> shape;
+        size_t offset = 0;
+    };
+
+    [[nodiscard]] NpyHeader read_npy_header(const MappedFile &file);
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
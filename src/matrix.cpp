@@ -0,0 +1,73 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Recurrence Matrix .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "matrix.h"
+//                * Include the used libraries.
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "threadpool.h"
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::RecurrenceMatrix::RecurrenceMatrix(const double *data_x, const std::vector<size_t> &dims_x,
+    const std::vector<std::ptrdiff_t> &strides_x, const double *data_y, const std::vector<size_t> &dims_y,
+    const std::vector<std::ptrdiff_t> &strides_y, const unsigned short metric, const double threshold,
+    const unsigned int threads) : limit(threshold), kind(metric) {
+
+    //      Check the input before to do anything.
+    if (dims_x.size() != 2 || dims_y.size() != 2)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Recurrence Matrix: the recurrence matrix requires time series.");
+    if (dims_x[0] != dims_y[0])
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Recurrence Matrix: data x and data y first dimension must have the same size.");
+
+    size_x = dims_x[1];
+    size_y = dims_y[1];
+    words = (size_x + MATRIX_WORD - 1) / MATRIX_WORD + 1;
+    bits.assign(size_y * words, 0);
+
+    //      A word is a 64 cells stencil: 64 consecutive x points against the same y point.
+    const Recurrence recurrence(metric, threshold, dims_x[0]);
+    std::vector<std::ptrdiff_t> word_x(MATRIX_WORD);
+    const std::vector<std::ptrdiff_t> word_y(MATRIX_WORD, 0);
+    for (size_t m = 0; m < MATRIX_WORD; m++) word_x[m] = static_cast<std::ptrdiff_t>(m) * strides_x[1];
+
+    const auto data_words = words - 1;
+    const auto tile_rows = (size_y + MATRIX_TILE_ROWS - 1) / MATRIX_TILE_ROWS;
+    const auto tile_columns = (data_words + MATRIX_TILE_WORDS - 1) / MATRIX_TILE_WORDS;
+
+    const auto workers = std::max(1u, threads);
+    const auto pool = ThreadPool::instance(workers);
+    pool->parallel_for(tile_rows * tile_columns, workers, 1, [&](unsigned int, const size_t begin, const size_t end) {
+        for (auto tile = begin; tile < end; tile++) {
+            const auto first_row = (tile / tile_columns) * MATRIX_TILE_ROWS;
+            const auto first_word = (tile % tile_columns) * MATRIX_TILE_WORDS;
+            const auto last_row = std::min(size_y, first_row + MATRIX_TILE_ROWS);
+            const auto last_word = std::min(data_words, first_word + MATRIX_TILE_WORDS);
+
+            for (auto j = first_row; j < last_row; j++) {
+                const auto *y = data_y + static_cast<std::ptrdiff_t>(j) * strides_y[1];
+                auto *line = bits.data() + j * words;
+
+                for (auto w = first_word; w < last_word; w++) {
+                    const auto first = w * MATRIX_WORD;
+                    const auto *x = data_x + static_cast<std::ptrdiff_t>(first) * strides_x[1];
+                    line[w] = recurrence(x, word_x.data(), strides_x[0], y, word_y.data(), strides_y[0],
+                        std::min<size_t>(MATRIX_WORD, size_x - first));
+                }
+            }
+        }
+    });
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,87 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Recurrence Matrix header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef MATRIX_H
+#define MATRIX_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "recurrence.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define MATRIX_WORD 64
+#define MATRIX_TILE_ROWS 64         //  A tile is 64 rows x 64 words (4096 columns), so its x points stay in cache.
+#define MATRIX_TILE_WORDS 64
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our RecurrenceMatrix class structure.
+    //      The recurrence plot of two time series at a fixed threshold and metric, stored as packed bits: the row j
+    //  holds the recurrences of all the x points with the y point j, 64 per word. It is built once, tile by tile
+    //  in parallel, and then any number of microstate structures and sample rates read their microstates from it
+    //  with word-level bit gathers, without computing any distance again.
+    class RecurrenceMatrix {
+        std::vector<uint64_t> bits;
+
+        size_t size_x;
+        size_t size_y;
+        size_t words;
+
+        double limit;
+        unsigned short kind;
+
+    public:
+        [[nodiscard]] size_t columns() const { return size_x; }
+        [[nodiscard]] size_t rows() const { return size_y; }
+        [[nodiscard]] size_t bytes() const { return bits.size() * sizeof(uint64_t); }
+        [[nodiscard]] double threshold() const { return limit; }
+        [[nodiscard]] unsigned short metric() const { return kind; }
+
+        [[nodiscard]] const uint64_t *row(const size_t j) const { return bits.data() + j * words; }
+
+        [[nodiscard]] bool operator()(const size_t i, const size_t j) const {
+            return row(j)[i / MATRIX_WORD] >> (i % MATRIX_WORD) & 1;
+        }
+
+        //      The microstate of a patch_x x patch_y structure at the column i and row j: each of its patch_y rows is
+        //  a gather of patch_x bits from (at most) two words. Every row has a padding word, so the second word can
+        //  always be read.
+        [[nodiscard]] uint64_t microstate(const size_t i, const size_t j, const size_t patch_x, const size_t patch_y) const {
+            const auto mask = patch_x == MATRIX_WORD ? ~uint64_t{0} : (uint64_t{1} << patch_x) - 1;
+            const auto word = i / MATRIX_WORD;
+            const auto shift = i % MATRIX_WORD;
+
+            uint64_t microstate = 0;
+            const auto *line = row(j) + word;
+            for (size_t b = 0; b < patch_y; b++, line += words) {
+                auto chunk = line[0] >> shift;
+                if (shift != 0) chunk |= line[1] << (MATRIX_WORD - shift);
+                microstate |= (chunk & mask) << (b * patch_x);
+            }
+
+            return microstate;
+        }
+
+        //      The data are time series, the dimensions and strides are given as a Tensor stores them: the first
+        //  (vector) dimension and the time. The rows are built by the given number of workers of the pool.
+        RecurrenceMatrix(const double *data_x, const std::vector<size_t> &dims_x, const std::vector<std::ptrdiff_t> &strides_x,
+            const double *data_y, const std::vector<size_t> &dims_y, const std::vector<std::ptrdiff_t> &strides_y,
+            unsigned short metric, double threshold, unsigned int threads);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
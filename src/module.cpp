@@ -14,22 +14,199 @@
 //      -------------------------------------------------------------------------------------------------------
 //            This is the C++ module that communicates with the Python interpreter using the PyBind11 library.
 //      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <numeric>
+#include <optional>
+#include <functional>
 //                * Include PyBind11
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 //                * Include the internal headers
 #include "tensor.h"
 #include "settings.h"
+#include "matrix.h"
+#include "mapped.h"
+#include "batch.h"
+#include "sampler.h"
 #include "probabilities.h"
+#include "sweep.h"
+#include "stream.h"
+#include "record.h"
+#include "arrays.h"
 //      -------------------------------------------------------------------------------------------------------
-inline pybind11::capsule settings(const pybind11::tuple &structure, const unsigned int threads = DEFAULT_THREADS, const bool force_dictionaries = false, const bool force_vectors = false) {
+inline pybind11::capsule settings(const pybind11::tuple &structure, const unsigned int threads = DEFAULT_THREADS, const bool force_dictionaries = false, const bool force_vectors = false,
+    const size_t dictionary_threshold = DEFAULT_HYPERVOLUME_TO_DICTIONARY, const bool profile = false) {
     const unsigned short mode = force_dictionaries ? MODE_FORCE_DICTIONARY : (force_vectors ? MODE_FORCE_VECTOR : MODE_DEFAULT);
-    const auto conf = new RecurrenceMicrostates::Settings(structure.cast<std::vector<size_t>>(), threads, mode);
+    const auto shape = structure.cast<std::vector<size_t>>();
+
+    //      The Settings may start the threads of the pool, so we do not hold the GIL while it is built: a job that is
+    //  running in another Python thread must not wait for us.
+    RecurrenceMicrostates::Settings *conf;
+    {
+        pybind11::gil_scoped_release release;
+        conf = new RecurrenceMicrostates::Settings(shape, threads, mode, dictionary_threshold, profile);
+    }
 
     return {conf, "settings_ptr", [](void *ptr) {
         delete static_cast<RecurrenceMicrostates::Settings *>(ptr);
     }};
 }
 //      -------------------------------------------------------------------------------------------------------
+inline std::unique_ptr<RecurrenceMicrostates::RecurrenceMatrix> recurrence_matrix(const pybind11::array_t<double> &data_x,
+    const pybind11::array_t<double> &data_y, const double threshold, const std::string &metric, const unsigned int threads) {
+    const RecurrenceMicrostates::Tensor<double> x(data_x);
+    const RecurrenceMicrostates::Tensor<double> y(data_y);
+    const auto kind = RecurrenceMicrostates::metric_from_name(metric);
+
+    pybind11::gil_scoped_release release;
+    return std::make_unique<RecurrenceMicrostates::RecurrenceMatrix>(x.pointer(), x.dimensions(), x.stride_table(), y.pointer(),
+        y.dimensions(), y.stride_table(), kind, threshold, threads);
+}
+//      -------------------------------------------------------------------------------------------------------
+inline std::unique_ptr<RecurrenceMicrostates::Stream> stream(const pybind11::capsule &settings, const pybind11::array_t<double> &params,
+    const size_t window, const std::string &metric, const bool expire) {
+    const auto arguments = RecurrenceMicrostates::numpy_to_vector(params);
+    if (arguments.empty()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Stream: the standard recurrence function requires a threshold parameter.");
+
+    return std::make_unique<RecurrenceMicrostates::Stream>(*static_cast<RecurrenceMicrostates::Settings *>(settings.get_pointer()),
+        arguments[0], window, RecurrenceMicrostates::metric_from_name(metric), expire);
+}
+//      -------------------------------------------------------------------------------------------------------
+inline void stream_push(RecurrenceMicrostates::Stream &stream, const pybind11::array_t<double> &chunk) {
+    const RecurrenceMicrostates::Tensor<double> data(chunk);
+    const auto &dims = data.dimensions();
+    if (dims.size() > 2) throw std::invalid_argument("[ERROR] Recurrence Microstates - Stream: a chunk must be (vector, time) or (time).");
+
+    const auto vector = dims.size() == 2 ? dims[0] : 1;
+    const auto step = dims.size() == 2 ? data.stride(0) : 0;
+
+    //      The stream waits for the pushes of the other threads, without the GIL.
+    pybind11::gil_scoped_release release;
+    stream.push(data.pointer(), vector, dims.back(), step, data.stride(dims.size() - 1));
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename F> auto stream_read(const RecurrenceMicrostates::Stream &stream, F &&read) {
+    decltype(read(stream)) values;
+    {
+        pybind11::gil_scoped_release release;
+        values = read(stream);
+    }
+    return RecurrenceMicrostates::take_array(std::move(values));
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T> pybind11::array mapped_array(std::unique_ptr<RecurrenceMicrostates::MappedFile> file, const std::string &path,
+    std::vector<size_t> dims, const size_t offset, const bool fortran_order, const bool whole) {
+    //      A raw file without a shape is a single series from offset to the end.
+    if (whole && offset <= file->size()) dims = {(file->size() - offset) / sizeof(T)};
+
+    const auto elements = std::accumulate(dims.begin(), dims.end(), size_t{1}, std::multiplies());
+    if (dims.empty() || offset % sizeof(T) != 0 || offset > file->size() || elements > (file->size() - offset) / sizeof(T))
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the shape and offset do not fit in the file '" + path + "'.");
+
+    //      The strides in bytes of a C (row-major) or Fortran (column-major) layout.
+    std::vector<pybind11::ssize_t> strides(dims.size());
+    pybind11::ssize_t step = sizeof(T);
+    for (size_t d = 0; d < dims.size(); d++) {
+        const auto axis = fortran_order ? d : dims.size() - 1 - d;
+        strides[axis] = step;
+        step *= static_cast<pybind11::ssize_t>(dims[axis]);
+    }
+
+    //      The array is a view over the mapping, which lives as long as the array (and any view of it) does.
+    const auto *pointer = reinterpret_cast<const T *>(file->data() + offset);
+    const pybind11::capsule owner(file.get(), [](void *ptr) {
+        delete static_cast<RecurrenceMicrostates::MappedFile *>(ptr);
+    });
+    file.release();
+
+    pybind11::array_t<T> array(std::vector<pybind11::ssize_t>(dims.begin(), dims.end()), strides, pointer, owner);
+    array.attr("setflags")(pybind11::arg("write") = false);
+    return array;
+}
+//      -------------------------------------------------------------------------------------------------------
+inline pybind11::array map_file(const std::string &path, const std::optional<std::vector<size_t>> &shape, size_t offset,
+    bool fortran_order, std::string dtype) {
+    auto file = std::make_unique<RecurrenceMicrostates::MappedFile>(path);
+    auto dims = shape.value_or(std::vector<size_t>{});
+
+    //      A .npy file brings its own type, shape and order.
+    if (path.ends_with(".npy")) {
+        const auto header = RecurrenceMicrostates::read_npy_header(*file);
+        const auto code = header.descr.size() == 3 && header.descr[0] != '>' ? header.descr.substr(1) : header.descr;
+
+        if (code == "f8") dtype = "float64";
+        else if (code == "f4") dtype = "float32";
+        else if (code == "i4") dtype = "int32";
+        else if (code == "i2") dtype = "int16";
+        else if (code == "u1") dtype = "uint8";
+        else throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: the .npy data type '" + header.descr + "' is not supported.");
+
+        dims = header.shape;
+        offset = header.offset;
+        fortran_order = header.fortran_order;
+    }
+
+    const auto whole = !shape && !path.ends_with(".npy");
+    if (dtype == "float64") return mapped_array<double>(std::move(file), path, dims, offset, fortran_order, whole);
+    if (dtype == "float32") return mapped_array<float>(std::move(file), path, dims, offset, fortran_order, whole);
+    if (dtype == "int32") return mapped_array<int32_t>(std::move(file), path, dims, offset, fortran_order, whole);
+    if (dtype == "int16") return mapped_array<int16_t>(std::move(file), path, dims, offset, fortran_order, whole);
+    if (dtype == "uint8") return mapped_array<uint8_t>(std::move(file), path, dims, offset, fortran_order, whole);
+
+    throw std::invalid_argument("[ERROR] Recurrence Microstates - MappedFile: unknown dtype '" + dtype + "', use 'float64', 'float32', 'int32', 'int16' or 'uint8'.");
+}
+//      -------------------------------------------------------------------------------------------------------
+inline pybind11::array_t<double> batch(const pybind11::capsule &settings, const pybind11::object &data, const pybind11::array_t<double> &params,
+    const double sample_rate, const std::string &metric, const std::optional<uint64_t> seed, const bool exhaustive) {
+    const auto &conf = *static_cast<RecurrenceMicrostates::Settings *>(settings.get_pointer());
+    const auto threshold = RecurrenceMicrostates::numpy_to_vector(params);
+    if (threshold.empty()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Batch: the standard recurrence function requires a threshold parameter.");
+
+    //      The series are views over the NumPy buffers: the rows of a (series, time) or (series, vector, time)
+    //  array, or the items of a list of (time) or (vector, time) arrays.
+    std::vector<RecurrenceMicrostates::Tensor<double>> tensors;
+    std::vector<RecurrenceMicrostates::SeriesView> series;
+    if (pybind11::isinstance<pybind11::array>(data)) {
+        const auto &all = tensors.emplace_back(data.cast<pybind11::array_t<double>>());
+        const auto &dims = all.dimensions();
+        if (dims.size() != 2 && dims.size() != 3)
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - Batch: a batch array must be (series, time) or (series, vector, time).");
+
+        for (size_t s = 0; s < dims[0]; s++) {
+            const auto *pointer = all.pointer() + static_cast<std::ptrdiff_t>(s) * all.stride(0);
+            if (dims.size() == 2) series.push_back({pointer, {1, dims[1]}, {0, all.stride(1)}});
+            else series.push_back({pointer, {dims[1], dims[2]}, {all.stride(1), all.stride(2)}});
+        }
+    } else {
+        for (const auto &item : data) {
+            const auto &one = tensors.emplace_back(item.cast<pybind11::array_t<double>>());
+            const auto &dims = one.dimensions();
+            if (dims.size() > 2)
+                throw std::invalid_argument("[ERROR] Recurrence Microstates - Batch: each series of a list must be (time) or (vector, time).");
+
+            if (dims.size() == 1) series.push_back({one.pointer(), {1, dims[0]}, {0, one.stride(0)}});
+            else series.push_back({one.pointer(), {dims[0], dims[1]}, one.stride_table()});
+        }
+    }
+
+    //      The checks come before the output, whose size would be wrong for a structure in the dictionary mode.
+    RecurrenceMicrostates::check_batch(conf, series);
+    pybind11::array_t<double> output(std::vector{static_cast<pybind11::ssize_t>(series.size()), static_cast<pybind11::ssize_t>(conf.possibilities())});
+    auto *result = output.mutable_data();
+    const auto kind = RecurrenceMicrostates::metric_from_name(metric);
+    const auto key = seed.value_or(RecurrenceMicrostates::random_seed());
+
+    pybind11::gil_scoped_release release;
+    RecurrenceMicrostates::count_batch(conf, series, kind, threshold[0], sample_rate, key, exhaustive, result);
+    return output;
+}
+//      -------------------------------------------------------------------------------------------------------
 //                * PyBind11 Module Settings
 PYBIND11_MODULE(microrecpy, m) {
     m.def("settings", &settings,
@@ -37,5 +214,175 @@ PYBIND11_MODULE(microrecpy, m) {
         pybind11::arg("threads") = DEFAULT_THREADS,
         pybind11::arg("force_dictionaries") = false,
         pybind11::arg("force_vectors") = false,
-        "Create a setting structure that control the process.");
+        pybind11::arg("dictionary_threshold") = DEFAULT_HYPERVOLUME_TO_DICTIONARY,
+        pybind11::arg("profile") = false,
+        "Create a setting structure that control the process. Microstates with a hypervolume above dictionary_threshold are counted in a hash histogram. "
+        "With profile = True, each Probabilities keeps per-thread counters and timers, read with stats() and trace().");
+
+    m.def("map_file", &map_file,
+        pybind11::arg("path"),
+        pybind11::arg("shape") = pybind11::none(),
+        pybind11::arg("offset") = 0,
+        pybind11::arg("fortran_order") = false,
+        pybind11::arg("dtype") = "float64",
+        "Map a .npy file, or a raw file of dtype values ('float64', 'float32', 'int32', 'int16' or 'uint8') from offset with the given shape, "
+        "into a read-only array without reading it. The pages are read by the OS as the samples touch them, so the data may be larger than the RAM. "
+        "np.memmap arrays of these types are also used without a copy.");
+
+    m.def("batch", &batch,
+        pybind11::arg("settings"),
+        pybind11::arg("data"),
+        pybind11::arg("params"),
+        pybind11::arg("sample_rate") = 0.2,
+        pybind11::arg("metric") = DEFAULT_METRIC,
+        pybind11::arg("seed") = pybind11::none(),
+        pybind11::arg("exhaustive") = false,
+        "Compute the recurrence microstates probabilities of many time series with the same settings, into a (series, 2^hypervolume) array. "
+        "The data is a (series, time) or (series, vector, time) array, or a list of (time) or (vector, time) arrays. The series s is sampled with the seed seed + s.");
+
+    pybind11::class_<RecurrenceMicrostates::RecurrenceMatrix>(m, "RecurrenceMatrix")
+        .def(pybind11::init(&recurrence_matrix),
+            pybind11::arg("data_x"),
+            pybind11::arg("data_y"),
+            pybind11::arg("threshold"),
+            pybind11::arg("metric") = DEFAULT_METRIC,
+            pybind11::arg("threads") = DEFAULT_THREADS,
+            "Compute the recurrence plot of two time series as packed bits, to be shared by many Probabilities at the same threshold.")
+        .def_property_readonly("columns", &RecurrenceMicrostates::RecurrenceMatrix::columns, "Number of points of data x.")
+        .def_property_readonly("rows", &RecurrenceMicrostates::RecurrenceMatrix::rows, "Number of points of data y.")
+        .def_property_readonly("threshold", &RecurrenceMicrostates::RecurrenceMatrix::threshold, "Threshold of the recurrences.")
+        .def_property_readonly("nbytes", &RecurrenceMicrostates::RecurrenceMatrix::bytes, "Memory used by the bits.")
+        .def("__call__", &RecurrenceMicrostates::RecurrenceMatrix::operator(), pybind11::arg("i"), pybind11::arg("j"),
+            "True when the x point i recurs with the y point j.");
+
+    pybind11::class_<RecurrenceMicrostates::Probabilities>(m, "Probabilities")
+        .def(pybind11::init<const pybind11::capsule &, const pybind11::object &, const pybind11::object &,
+                const pybind11::array_t<double> &, double, const pybind11::object &, const std::string &, size_t, std::optional<uint64_t>, bool,
+                const RecurrenceMicrostates::RecurrenceMatrix *, std::optional<bool>, std::optional<double>, const std::string &, size_t,
+                std::optional<std::pair<size_t, size_t>>>(),
+            pybind11::arg("settings"),
+            pybind11::arg("data_x"),
+            pybind11::arg("data_y"),
+            pybind11::arg("params"),
+            pybind11::arg("sample_rate") = 0.2,
+            pybind11::arg("func") = pybind11::none(),
+            pybind11::arg("metric") = DEFAULT_METRIC,
+            pybind11::arg("batch_size") = DEFAULT_CALLBACK_BATCH,
+            pybind11::arg("seed") = pybind11::none(),
+            pybind11::arg("exhaustive") = false,
+            pybind11::arg("matrix") = pybind11::none(),
+            pybind11::arg("tiled") = pybind11::none(),
+            pybind11::arg("tolerance") = pybind11::none(),
+            pybind11::arg("criterion") = DEFAULT_CRITERION,
+            pybind11::arg("min_samples") = ADAPTIVE_MIN_SAMPLES,
+            pybind11::arg("shard") = pybind11::none(),
+            "Compute the recurrence microstates probabilities. The built-in recurrence uses params[0] as threshold with the 'euclidean', 'chebyshev' or 'manhattan' metric. "
+            "Data x and y of the same float64, float32, int32, int16 or uint8 dtype are read without a conversion; for the integers the threshold is rounded down "
+            "and a threshold below one compares the values for equality. Any other data is converted to float64. "
+            "With batch_size > 0, func(X, Y, params) receives (pairs, length) arrays of about batch_size pairs and returns one boolean per pair. "
+            "With exhaustive = True, every microstate of the recurrence plot of two time series, or of two 2-D or 3-D fields (images, volumes), "
+            "is counted (sample_rate and seed are ignored). "
+            "A RecurrenceMatrix built from the same data, threshold and metric replaces the distance computations. "
+            "With tiled = True the samples are drawn tile by tile, strips of a series and blocks of a field (the default for data above 64 MB), "
+            "so each thread works on cache-sized blocks and a mapped file is read in sequence; the result of a seed depends on this choice. "
+            "With a tolerance, the samples are taken in rounds (min_samples, then doubling) until the 'entropy' or the 'max' probability changes "
+            "less than the tolerance between two rounds, or the samples of sample_rate run out. "
+            "With shard = (k, n) only the k-th of n equal parts of the samples of the seed is counted; the merged histogram() of the n shards "
+            "equals the result of a single run with the same seed.")
+        .def("probabilities", &RecurrenceMicrostates::Probabilities::probabilities,
+            "Get the probability of each microstate, as a read-only view. In the dictionary mode they follow the microstates of keys().")
+        .def("keys", &RecurrenceMicrostates::Probabilities::keys,
+            "Get the microstates found in the dictionary mode, in ascending order, as a read-only view.")
+        .def("counts", &RecurrenceMicrostates::Probabilities::counts,
+            "Get the number of occurrences of each microstate, following keys() in the dictionary mode, as a read-only view.")
+        .def("histogram", &RecurrenceMicrostates::Probabilities::histogram,
+            "Get the exact counts with the structure, metric, threshold, samples and seed, to be saved or merged with other runs. "
+            "A run with a user recurrence function has no threshold, so it has no histogram.")
+        .def("stats", &RecurrenceMicrostates::Probabilities::stats,
+            "Get the counters of a profiled run: samples, recurrence evaluations, callbacks and bytes loaded, the wall seconds of each phase "
+            "('count', 'callback', 'reduce', 'normalize'), the imbalance (busiest thread over the mean in 'count') and the same per worker.")
+        .def("trace", &RecurrenceMicrostates::Probabilities::trace, pybind11::arg("path"),
+            "Write the phases of each thread of a profiled run as a Chrome trace-event JSON file (chrome://tracing or Perfetto).")
+        .def_property_readonly("dictionary", &RecurrenceMicrostates::Probabilities::dictionary,
+            "True when the result is sparse (dictionary mode).")
+        .def_property_readonly("seed", &RecurrenceMicrostates::Probabilities::seed,
+            "Seed of the samples, giving it back reproduces the same result.")
+        .def_property_readonly("tiled", &RecurrenceMicrostates::Probabilities::tiled,
+            "True when the samples were drawn in the tiled order.")
+        .def_property_readonly("samples", &RecurrenceMicrostates::Probabilities::samples,
+            "Number of microstates counted.")
+        .def_property_readonly("converged", &RecurrenceMicrostates::Probabilities::converged,
+            "True when an adaptive run stopped on its tolerance, before the samples of sample_rate ran out.");
+
+    pybind11::class_<RecurrenceMicrostates::HistogramRecord>(m, "Histogram")
+        .def(pybind11::init([](const pybind11::bytes &data) { return RecurrenceMicrostates::HistogramRecord(static_cast<std::string>(data)); }),
+            pybind11::arg("data"),
+            "Read a histogram from the bytes of to_bytes().")
+        .def("to_bytes", [](const RecurrenceMicrostates::HistogramRecord &record) { return pybind11::bytes(record.bytes()); },
+            "Get the histogram as little-endian bytes, to be stored or sent to another process.")
+        .def("merge", &RecurrenceMicrostates::HistogramRecord::merge, pybind11::arg("other"),
+            "Add the counts of another histogram of the same structure, metric and threshold. The merge is associative and commutative.")
+        .def("probabilities", [](const RecurrenceMicrostates::HistogramRecord &record) { return RecurrenceMicrostates::take_array(record.probabilities()); },
+            "Get the probability of each microstate. In the dictionary mode they follow the microstates of keys().")
+        .def("keys", [](const RecurrenceMicrostates::HistogramRecord &record) { return RecurrenceMicrostates::view_array(&record, record.keys()); },
+            "Get the microstates found in the dictionary mode, in ascending order, as a read-only view.")
+        .def("counts", [](const RecurrenceMicrostates::HistogramRecord &record) { return RecurrenceMicrostates::view_array(&record, record.counts()); },
+            "Get the number of occurrences of each microstate, following keys() in the dictionary mode, as a read-only view.")
+        .def_property_readonly("structure", &RecurrenceMicrostates::HistogramRecord::structure, "Structure of the microstates.")
+        .def_property_readonly("metric", &RecurrenceMicrostates::HistogramRecord::metric, "Metric code of the recurrence.")
+        .def_property_readonly("threshold", &RecurrenceMicrostates::HistogramRecord::threshold,
+            "Threshold of the recurrence, NaN for a user function.")
+        .def_property_readonly("samples", &RecurrenceMicrostates::HistogramRecord::samples, "Number of microstates counted.")
+        .def_property_readonly("seed", &RecurrenceMicrostates::HistogramRecord::seed,
+            "Seed of the samples, 2^64 - 1 after a merge of different seeds.")
+        .def_property_readonly("dictionary", &RecurrenceMicrostates::HistogramRecord::dictionary,
+            "True when the counts are sparse (dictionary mode).");
+
+    pybind11::class_<RecurrenceMicrostates::Sweep>(m, "Sweep")
+        .def(pybind11::init<const pybind11::capsule &, const pybind11::array_t<double> &, const pybind11::array_t<double> &,
+                const pybind11::array_t<double> &, double, const std::string &, std::optional<uint64_t>>(),
+            pybind11::arg("settings"),
+            pybind11::arg("data_x"),
+            pybind11::arg("data_y"),
+            pybind11::arg("thresholds"),
+            pybind11::arg("sample_rate") = 0.2,
+            pybind11::arg("metric") = DEFAULT_METRIC,
+            pybind11::arg("seed") = pybind11::none(),
+            "Compute the recurrence microstates probabilities for many thresholds in a single pass over the samples.")
+        .def("probabilities", &RecurrenceMicrostates::Sweep::probabilities,
+            "Get the (thresholds, 2^hypervolume) probabilities. In the dictionary mode they follow rows() and keys().")
+        .def("thresholds", &RecurrenceMicrostates::Sweep::thresholds,
+            "Get the thresholds, in the order of the rows.")
+        .def("rows", &RecurrenceMicrostates::Sweep::rows,
+            "Get the threshold (row) of each entry in the dictionary mode.")
+        .def("keys", &RecurrenceMicrostates::Sweep::keys,
+            "Get the microstate of each entry in the dictionary mode.")
+        .def("counts", &RecurrenceMicrostates::Sweep::counts,
+            "Get the number of occurrences of each entry in the dictionary mode.")
+        .def_property_readonly("dictionary", &RecurrenceMicrostates::Sweep::dictionary,
+            "True when the result is sparse (dictionary mode).")
+        .def_property_readonly("seed", &RecurrenceMicrostates::Sweep::seed,
+            "Seed of the samples, giving it back reproduces the same result.");
+
+    pybind11::class_<RecurrenceMicrostates::Stream>(m, "Stream")
+        .def(pybind11::init(&stream),
+            pybind11::arg("settings"),
+            pybind11::arg("params"),
+            pybind11::arg("window"),
+            pybind11::arg("metric") = DEFAULT_METRIC,
+            pybind11::arg("expire") = true,
+            "Keep the microstates histogram of a time series that arrives in chunks, over the last window points. "
+            "Without expire, the microstates of the points that leave the window stay counted.")
+        .def("push", &stream_push, pybind11::arg("chunk"),
+            "Add a chunk of points, given as (vector, time) or (time).")
+        .def("snapshot", [](const RecurrenceMicrostates::Stream &stream) { return stream_read(stream, std::mem_fn(&RecurrenceMicrostates::Stream::snapshot)); },
+            "Get the probability of each microstate now. In the dictionary mode they follow the microstates of keys().")
+        .def("keys", [](const RecurrenceMicrostates::Stream &stream) { return stream_read(stream, std::mem_fn(&RecurrenceMicrostates::Stream::keys)); },
+            "Get the microstates found in the dictionary mode, in ascending order.")
+        .def("counts", [](const RecurrenceMicrostates::Stream &stream) { return stream_read(stream, std::mem_fn(&RecurrenceMicrostates::Stream::counts)); },
+            "Get the number of occurrences of each microstate, following keys() in the dictionary mode.")
+        .def_property_readonly("points", &RecurrenceMicrostates::Stream::size, "Number of points pushed.")
+        .def_property_readonly("microstates", &RecurrenceMicrostates::Stream::microstates, "Number of microstates in the histogram.")
+        .def_property_readonly("dictionary", &RecurrenceMicrostates::Stream::dictionary,
+            "True when the result is sparse (dictionary mode).");
 }
\ No newline at end of file
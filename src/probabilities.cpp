@@ -15,22 +15,25 @@
 #include "probabilities.h"
 //                * Include the used libraries.
 #include <tuple>
+#include <memory>
+#include <string>
 #include <vector>
-#include <random>
-#include <future>
+#include <variant>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <cmath>
+#include <functional>
 #include <numeric>
+#include <algorithm>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
-//      -------------------------------------------------------------------------------------------------------
-bool RecurrenceMicrostates::std_recurrence(const std::vector<double> &x, const std::vector<double> &y,
-    const std::vector<double> &params) {
-
-    if (params.empty()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the standard recurrence function requires a threshold parameter.");
 
-    auto distance = 0.0;
-    for (size_t i = 0; i < x.size(); i++) distance += std::pow(x[i] - y[i], 2);
-    return params[0] - std::sqrt(distance) >= 0;
-}
+#include "counting.h"
+#include "scan.h"
+#include "spatial.h"
+#include "threadpool.h"
+#include "arrays.h"
 //      -------------------------------------------------------------------------------------------------------
 template<typename T> std::vector<T> RecurrenceMicrostates::numpy_to_vector(const pybind11::array_t<T> &array) {
     pybind11::buffer_info info = array.request();
@@ -41,87 +44,213 @@ template<typename T> std::vector<T> RecurrenceMicrostates::numpy_to_vector(const
     return std::vector<T>(data, data + info.shape[0]);
 }
 //      -------------------------------------------------------------------------------------------------------
-void RecurrenceMicrostates::Probabilities::compute_to_vector(const std::vector<double> &params) {
-    //      Alloc some memory =3
-    size_t counter = 0;
+void RecurrenceMicrostates::check_data(const Settings &settings, const std::vector<size_t> &dims_x, const std::vector<size_t> &dims_y) {
+    if (dims_x != dims_y)
+        throw std::invalid_argument(
+            "[ERROR] Recurrence Microstates - Probabilities: data x and data y must have the same number of dimensions.");
+    if (dims_x[0] != dims_y[0])
+        throw std::invalid_argument(
+            "[ERROR] Recurrence Microstates - Probabilities: data x and data y first dimension must have the same size.");
 
-    //      Create the async tasks...
-    std::vector<std::future<std::tuple<std::vector<size_t>, size_t>>> tasks;
-    tasks.reserve(settings.available_threads());
-    for (unsigned int i = 0; i < settings.available_threads(); i++)
-        tasks.push_back(std::async(std::launch::async, task_compute_using_vector, this->samples[i], this->settings,
-            this->data_x, this->data_y, params, this->function));
-
-    std::vector<std::tuple<std::vector<size_t>, size_t>> results;
-    results.reserve(settings.available_threads());
-    for (auto &f : tasks)
-        results.push_back(f.get());
-
-    for (auto &r : results)
-        counter += std::get<1>(r);
-
-    this->vect_result.resize(settings.possibilities());
-    for (auto &r : results) {
-        auto probs = std::get<0>(r);
-        for (size_t i = 0; i < probs.size(); i++)
-            this->vect_result[i] = probs[i] / static_cast<double>(counter);
+    if (settings.dimensions() != 2 * (dims_x.size() - 1))
+        throw std::invalid_argument(
+            "[ERROR] Recurrence Microstates - Settings: the configured microstate structure and the given data are not compatible.");
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename Task> void RecurrenceMicrostates::Probabilities::collect(const size_t count, const size_t chunk, Task &&task) {
+    //      The raw counts are kept with the probabilities, for counts() and histogram().
+    if (this->settings.dictionary()) {
+        FlatHistogram histogram;
+        used = count_sparse(settings, count, chunk, task, histogram, profiler.get());
+        histogram.sorted(dict_keys, dict_counts);
+    } else used = count_dense(settings, count, chunk, task, vect_counts, profiler.get());
+
+    normalize_counts(settings, this->settings.dictionary() ? dict_counts : vect_counts, used, vect_result, profiler.get());
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename Task> void RecurrenceMicrostates::Probabilities::collect_samples(const size_t count, const size_t chunk, Task &&task) {
+    //      A shard takes its share [first, last) of the samples of the seed, so the shards of a seed together are
+    //  exactly the samples of a single run.
+    const auto first = static_cast<size_t>(static_cast<unsigned __int128>(count) * shard_index / shard_count);
+    const auto last = static_cast<size_t>(static_cast<unsigned __int128>(count) * (shard_index + 1) / shard_count);
+    const auto shifted = [&](const size_t begin, const size_t end, auto &&add) { return task(first + begin, first + end, add); };
+
+    if (tolerance) collect_adaptive(last - first, chunk, shifted);
+    else collect(last - first, chunk, shifted);
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename Task> void RecurrenceMicrostates::Probabilities::collect_adaptive(const size_t count, const size_t chunk, Task &&task) {
+    //      Since the sample i depends only on (seed, i), the rounds together are exactly the first samples of the
+    //  fixed run. In the tiled order those would be only the first tiles, so the rounds take the samples in an
+    //  order spread over all of them instead, and a run to the end is still the fixed one.
+    Convergence convergence(criterion, *tolerance);
+    auto &counts = this->settings.dictionary() ? dict_counts : vect_counts;
+
+    if (sampler.tiled()) used = count_adaptive(settings, count, chunk, spread_task(count, chunk, task), convergence, min_samples,
+        dict_keys, counts, stopped, profiler.get());
+    else used = count_adaptive(settings, count, chunk, task, convergence, min_samples, dict_keys, counts, stopped, profiler.get());
+
+    normalize_counts(settings, counts, used, vect_result, profiler.get());
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Probabilities::compute_sampled(const std::vector<double> &params, const RecurrenceMatrix *matrix) {
+    if (matrix != nullptr) {
+        //      A microstate from the matrix reads one word of bits per row of its patch, with no evaluation.
+        if (profiler) profiler->costs(0, settings.patch_y() * sizeof(uint64_t));
+
+        collect_samples(sampler.size(), DEFAULT_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+            return count_microstates(sampler, begin, end, *matrix, settings.patch_x(), settings.patch_y(), count);
+        });
+        return;
     }
+
+    //      The samples are taken in chunks by the threads of the pool, each one counting into its own histogram.
+    //  The tensors are views over the NumPy buffers and are shared by reference, so nothing is copied here.
+    std::visit([&]<typename T>(const Tensor<T> &x) {
+        const auto &y = std::get<Tensor<T>>(data_y);
+        if (profiler) profiler->costs(stencil.cells(), 2 * stencil.cells() * stencil.vector_size() * sizeof(T));
+
+        collect_samples(sampler.size(), chunk(), [&](const size_t begin, const size_t end, auto &&count) {
+            return task_compute(sampler, begin, end, settings, stencil, x, y, params, function, metric, batch, profiler.get(), count);
+        });
+    }, data_x);
 }
 //      -------------------------------------------------------------------------------------------------------
-std::tuple<std::vector<size_t>, size_t> RecurrenceMicrostates::Probabilities::task_compute_using_vector(
-    const std::vector<std::vector<size_t>> &samples, const Settings &settings, const Tensor<double> &data_x,
-    const Tensor<double> &data_y, const std::vector<double> &params, const pybind11::function &function) {
+void RecurrenceMicrostates::Probabilities::compute_exhaustive(const std::vector<double> &params, const RecurrenceMatrix *matrix) {
+    if (matrix != nullptr) {
+        if (profiler) profiler->costs(0, settings.patch_y() * sizeof(uint64_t));
+        collect(matrix->rows() - settings.patch_y() + 1, SCAN_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+            return scan_microstates(begin, end, *matrix, settings.patch_x(), settings.patch_y(), count);
+        });
+        return;
+    }
 
-    std::vector<size_t> result(settings.possibilities(), 0);
-    size_t counter = 0;
+    if (!function.is_none()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the exhaustive mode only works with the built-in recurrence.");
+    if (params.empty()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the standard recurrence function requires a threshold parameter.");
 
-    std::vector<size_t> indexes(settings.dimensions(), 0);
+    //      Every microstate of the recurrence plot, each task walking its own rows. The time series use Scan,
+    //  the 2-D and 3-D fields use Spatial.
+    std::visit([&]<typename T>(const Tensor<T> &x) {
+        const auto &y = std::get<Tensor<T>>(data_y);
+        const BasicRecurrence<T> recurrence(metric, params[0], stencil.vector_size());
+        if (profiler) profiler->costs(stencil.cells(), 2 * stencil.cells() * stencil.vector_size() * sizeof(T));
+
+        if (x.dimensions().size() == 2) {
+            const BasicScan<T> scan(settings, x.pointer(), x.dimensions(), x.stride_table(), y.pointer(), y.dimensions(), y.stride_table(), recurrence);
+            collect(scan.rows(), SCAN_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+                return scan(begin, end, count);
+            });
+        } else {
+            const BasicSpatial<T> spatial(settings, x.pointer(), x.dimensions(), x.stride_table(), y.pointer(), y.dimensions(), y.stride_table(), recurrence);
+            collect(spatial.rows(), spatial.chunk(), [&](const size_t begin, const size_t end, auto &&count) {
+                return spatial(begin, end, count);
+            });
+        }
+    }, data_x);
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T, typename Counter>
+size_t RecurrenceMicrostates::Probabilities::task_compute(const Sampler &sampler,
+    const size_t begin, const size_t end, const Settings &settings, const Stencil &stencil, const Tensor<T> &data_x, const Tensor<T> &data_y,
+    const std::vector<double> &params, const pybind11::object &function, const unsigned short metric, const size_t batch,
+    Profiler *profiler, Counter &&count) {
 
-    for (auto &sample : samples) {
-        size_t add = 0;
-        std::ranges::fill(indexes, 0);
+    size_t counter = 0;
 
-        const std::vector index_x(sample.begin(), sample.begin() + settings.dimensions() / 2);
-        const std::vector index_y(sample.begin() + settings.dimensions() / 2, sample.end());
+    const auto cells = stencil.cells();
+    const auto length = stencil.vector_size();
+    const auto step_x = stencil.step_x();
+    const auto step_y = stencil.step_y();
+    const auto *offsets_x = stencil.offsets_x();
+    const auto *offsets_y = stencil.offsets_y();
+
+    //      The samples are drawn on demand into a single buffer for the whole task, with the tile of the last one.
+    std::vector<size_t> sample(sampler.dimensions());
+    auto cursor = sampler.cursor();
+
+    //      Each microstate is a fixed sequence of loads at the stencil offsets, no allocation is made per sample.
+    if (function.is_none()) {
+        if (params.empty()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the standard recurrence function requires a threshold parameter.");
+
+        const BasicRecurrence<T> recurrence(metric, params[0], length, settings.specialization());
+        counter += count_microstates(sampler, begin, end, stencil, data_x.pointer(), data_y.pointer(), recurrence, count);
+    } else if (batch == 0) {
+        //      The user function receives vectors, so we keep two buffers for the whole task.
+        std::vector<double> x(length);
+        std::vector<double> y(length);
+
+        for (auto s = begin; s < end; s++) {
+            sampler(s, sample.data(), cursor);
+            const auto *base_x = data_x.pointer() + stencil.base_x(sample.data());
+            const auto *base_y = data_y.pointer() + stencil.base_y(sample.data());
+
+            uint64_t add = 0;
+            for (size_t m = 0; m < cells; m++) {
+                const auto *px = base_x + offsets_x[m];
+                const auto *py = base_y + offsets_y[m];
+                for (size_t i = 0; i < length; i++) {
+                    x[i] = px[static_cast<std::ptrdiff_t>(i) * step_x];
+                    y[i] = py[static_cast<std::ptrdiff_t>(i) * step_y];
+                }
+
+                const auto start = profiler != nullptr ? profiler->now() : 0.0;
+                add |= static_cast<uint64_t>(call_user_function(x, y, params, function)) << m;
+                if (profiler != nullptr) profiler->callback(start);
+            }
 
-        for (size_t m = 0; m < settings.get_hypervolume(); m++) {
-            const std::vector recursive_x(indexes.begin(), indexes.begin() + settings.dimensions() / 2);
-            const std::vector recursive_y(indexes.begin() + settings.dimensions() / 2, indexes.end());
+            count(add);
+            counter++;
+        }
+    } else {
+        //      The batched protocol: the pairs of whole samples are gathered into (pairs, length) blocks without the
+        //  GIL, and the user function is called once per block returning one boolean per pair.
+        const auto per_call = std::max<size_t>(1, batch / cells);
+        std::vector<double> x(per_call * cells * length);
+        std::vector<double> y(per_call * cells * length);
+        std::vector<uint8_t> recurrent(per_call * cells);
+
+        for (auto first = begin; first < end; first += per_call) {
+            const auto last = std::min(end, first + per_call);
+
+            size_t row = 0;
+            for (auto s = first; s < last; s++) {
+                sampler(s, sample.data(), cursor);
+                const auto *base_x = data_x.pointer() + stencil.base_x(sample.data());
+                const auto *base_y = data_y.pointer() + stencil.base_y(sample.data());
+
+                for (size_t m = 0; m < cells; m++, row++) {
+                    const auto *px = base_x + offsets_x[m];
+                    const auto *py = base_y + offsets_y[m];
+                    for (size_t i = 0; i < length; i++) {
+                        x[row * length + i] = px[static_cast<std::ptrdiff_t>(i) * step_x];
+                        y[row * length + i] = py[static_cast<std::ptrdiff_t>(i) * step_y];
+                    }
+                }
+            }
 
-            const auto x = get_data(data_x, index_x, recursive_x);
-            const auto y = get_data(data_y, index_y, recursive_y);
+            const auto start = profiler != nullptr ? profiler->now() : 0.0;
+            call_user_batch(x, y, row, length, params, function, recurrent);
+            if (profiler != nullptr) profiler->callback(start);
 
-            add += settings.power(m) * (function.is_none() ? std_recurrence(x, y, params) : call_user_function(x, y, params, function));
+            row = 0;
+            for (auto s = first; s < last; s++) {
+                uint64_t add = 0;
+                for (size_t m = 0; m < cells; m++, row++) add |= static_cast<uint64_t>(recurrent[row] != 0) << m;
 
-            //      Increment the recursive index.
-            indexes[0]++;
-            for (size_t k = 0; k < settings.dimensions() - 1; k++) {
-                if (indexes[k] > settings.structure(k)) {
-                    indexes[k+1]++;
-                    indexes[k] = 0;
-                } else break;
+                count(add);
+                counter++;
             }
         }
-
-        result[add]++;
-        counter++;
     }
 
-    return std::make_tuple(result, counter);
-}
-//      -------------------------------------------------------------------------------------------------------
-std::vector<double> RecurrenceMicrostates::Probabilities::get_data(const Tensor<double> tensor,
-    const std::vector<size_t> &fixed_indexes, const std::vector<size_t> &recursive_indexes) {
-    std::vector<size_t> indexes;
-    for (size_t i = 0; i < tensor.dimensions().size() - 1; i++)
-        indexes.push_back(fixed_indexes[i] + recursive_indexes[i]);
-
-    return tensor.vector(indexes);
+    return counter;
 }
 //      -------------------------------------------------------------------------------------------------------
 bool RecurrenceMicrostates::Probabilities::call_user_function(const std::vector<double> &x,
-    const std::vector<double> &y, const std::vector<double> &params, const pybind11::function &function) {
+    const std::vector<double> &y, const std::vector<double> &params, const pybind11::object &function) {
 
+    //      The workers run without the GIL, it is taken only to call into Python.
+    pybind11::gil_scoped_acquire gil;
     return function(
         pybind11::array_t(x.size(), x.data()),
         pybind11::array_t(y.size(), y.data()),
@@ -129,73 +258,159 @@ bool RecurrenceMicrostates::Probabilities::call_user_function(const std::vector<
     ).cast<bool>();
 }
 //      -------------------------------------------------------------------------------------------------------
-RecurrenceMicrostates::Probabilities::Probabilities(const pybind11::capsule &settings, const pybind11::array_t<double> &data_x,
-              const pybind11::array_t<double> &data_y, const pybind11::array_t<double> &params, double sample_rate,
-              const pybind11::function &func) : sample_rate(sample_rate), function(func), data_x(data_x), data_y(data_y),
-              settings(*static_cast<Settings*>(settings.get_pointer())){
+void RecurrenceMicrostates::Probabilities::call_user_batch(const std::vector<double> &x, const std::vector<double> &y,
+    const size_t pairs, const size_t length, const std::vector<double> &params, const pybind11::object &function,
+    std::vector<uint8_t> &recurrent) {
 
-    //      Check the input arguments.
-    if (this->data_x.dimensions() != this->data_y.dimensions())
-        throw std::invalid_argument(
-            "[ERROR] Recurrence Microstates - Probabilities: data x and data y must have the same number of dimensions.");
-    if (this->data_x.dimension(0) != this->data_y.dimension(0))
-        throw std::invalid_argument(
-            "[ERROR] Recurrence Microstates - Probabilities: data x and data y first dimension must have the same size.");
-
-    const auto dims = this->data_x.dimensions().size() - 1;
-    const auto D = 2 * dims;
-
-    if (this->settings.dimensions() != D)
-        throw std::invalid_argument(
-            "[ERROR] Recurrence Microstates - Settings: the configured microstate structure and the given data are not compatible.");
-
-    //      Get the dimensions.
-    auto dims_x = this->data_x.dimensions();
-    auto dims_y = this->data_y.dimensions();
+    pybind11::gil_scoped_acquire gil;
 
-    //      Compute the recurrence space hypervolume.
-    const auto hypervolume = std::accumulate(dims_x.begin() + 1, dims_x.end(), size_t{1}, std::multiplies()) *
-                             std::accumulate(dims_y.begin() + 1, dims_y.end(), size_t{1}, std::multiplies());
+    const std::vector shape{static_cast<pybind11::ssize_t>(pairs), static_cast<pybind11::ssize_t>(length)};
+    const auto result = pybind11::array_t<bool, pybind11::array::c_style | pybind11::array::forcecast>::ensure(function(
+        pybind11::array_t<double>(shape, x.data()),
+        pybind11::array_t<double>(shape, y.data()),
+        pybind11::array_t<double>(params.size(), params.data())
+    ));
 
-    //      Number of samples to take.
-    const auto numb_samples = static_cast<size_t>(std::floor(static_cast<double>(hypervolume) * sample_rate));
-    //      Get the samples.
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    if (!result || static_cast<size_t>(result.size()) != pairs)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the batched recurrence function must return one boolean for each pair.");
 
-    std::vector samples(numb_samples, std::vector<size_t>(D, 0));
-    for (size_t dim = 0; dim < dims; dim++) {
-        const auto max_x = dims_x[dim + 1] - this->settings.structure(dim);
-        const auto max_y = dims_y[dim + 1] - this->settings.structure(dim);
+    std::copy_n(result.data(), pairs, recurrent.begin());
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Probabilities::check_matrix(const RecurrenceMatrix &matrix, const std::vector<double> &params) const {
+    if (!function.is_none())
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: a recurrence matrix only works with the built-in recurrence.");
+    const auto &dims_x = dimensions(data_x);
+    const auto &dims_y = dimensions(data_y);
+    if (dims_x.size() != 2 || matrix.columns() != dims_x[1] || matrix.rows() != dims_y[1])
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the recurrence matrix was not built from data with this shape.");
+    if (params.empty() || params[0] != matrix.threshold() || metric != matrix.metric())
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the recurrence matrix was built with another threshold or metric.");
+}
+//      -------------------------------------------------------------------------------------------------------
+size_t RecurrenceMicrostates::Probabilities::chunk() const {
+    //      A batched callback needs chunks of at least one batch, otherwise the calls would be smaller than asked.
+    if (function.is_none() || batch == 0) return DEFAULT_CHUNK;
+    return std::max<size_t>(DEFAULT_CHUNK, batch / stencil.cells() + 1);
+}
+//      -------------------------------------------------------------------------------------------------------
+std::vector<size_t> RecurrenceMicrostates::Probabilities::tiling(const Data &data, const Data &other, const std::optional<bool> tiled) {
+    //      By default the tiled order is taken only when the data does not fit in the caches with a good margin.
+    const auto bytes = [](const Data &tensor) {
+        return std::accumulate(dimensions(tensor).begin(), dimensions(tensor).end(), element_size(tensor), std::multiplies());
+    };
+
+    if (dimensions(data).size() < 2) return {};
+    if (!tiled.value_or(bytes(data) + bytes(other) >= TILE_AUTO_BYTES)) return {};
+    return tile_lengths(dimensions(data), element_size(data));
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<double> RecurrenceMicrostates::Probabilities::probabilities() const {
+    return view_array(this, vect_result);
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<uint64_t> RecurrenceMicrostates::Probabilities::keys() const {
+    if (!this->settings.dictionary()) throw std::runtime_error("[ERROR] Recurrence Microstates - Probabilities: keys are only available in the dictionary mode, use probabilities().");
+    return view_array(this, dict_keys);
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<size_t> RecurrenceMicrostates::Probabilities::counts() const {
+    return view_array(this, this->settings.dictionary() ? dict_counts : vect_counts);
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::HistogramRecord RecurrenceMicrostates::Probabilities::histogram() const {
+    if (std::isnan(threshold)) throw std::runtime_error("[ERROR] Recurrence Microstates - Probabilities: a run with a user recurrence function has no threshold, its histogram cannot be recorded.");
 
-        std::uniform_int_distribution<size_t> dist_x(0, max_x);
-        std::uniform_int_distribution<size_t> dist_y(0, max_y);
+    std::vector<size_t> structure(settings.dimensions());
+    for (size_t d = 0; d < structure.size(); d++) structure[d] = settings.structure(d);
 
-        for (size_t i = 0; i < numb_samples; i++) {
-            samples[i][dim] = dist_x(gen);
-            samples[i][dims + dim] = dist_y(gen);
-        }
+    const auto &counts = this->settings.dictionary() ? dict_counts : vect_counts;
+    return {structure, metric, threshold, used, seed(), this->settings.dictionary(), {dict_keys.begin(), dict_keys.end()},
+        {counts.begin(), counts.end()}};
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::dict RecurrenceMicrostates::Probabilities::stats() const {
+    if (!profiler) throw std::runtime_error("[ERROR] Recurrence Microstates - Probabilities: the run was not profiled, create the settings with profile = True.");
+
+    //      The totals, the wall time of each phase and the counters of each worker.
+    pybind11::dict phases;
+    for (unsigned short phase = 0; phase < PHASES; phase++) phases[Profiler::phase_name(phase)] = profiler->wall(phase);
+
+    size_t samples = 0, evaluations = 0, callbacks = 0, bytes = 0;
+    pybind11::list workers;
+    for (const auto &worker : profiler->workers()) {
+        samples += worker.samples;
+        evaluations += worker.evaluations;
+        callbacks += worker.callbacks;
+        bytes += worker.bytes;
+
+        pybind11::dict times;
+        for (unsigned short phase = 0; phase < PHASES; phase++) times[Profiler::phase_name(phase)] = worker.seconds[phase];
+
+        pybind11::dict one;
+        one["samples"] = worker.samples;
+        one["evaluations"] = worker.evaluations;
+        one["callbacks"] = worker.callbacks;
+        one["bytes"] = worker.bytes;
+        one["chunks"] = worker.chunks;
+        one["seconds"] = times;
+        workers.append(one);
     }
 
-    //      Now, we divide the work between each available thread =D
-    const auto int_number = numb_samples / this->settings.available_threads();
-    auto rest_number = numb_samples % this->settings.available_threads();
-    size_t start_index = 0;
+    pybind11::dict stats;
+    stats["threads"] = profiler->workers().size();
+    stats["samples"] = samples;
+    stats["evaluations"] = evaluations;
+    stats["callbacks"] = callbacks;
+    stats["bytes"] = bytes;
+    stats["seconds"] = phases;
+    stats["imbalance"] = profiler->imbalance();
+    stats["workers"] = workers;
+    return stats;
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Probabilities::trace(const std::string &path) const {
+    if (!profiler) throw std::runtime_error("[ERROR] Recurrence Microstates - Probabilities: the run was not profiled, create the settings with profile = True.");
+    profiler->write_trace(path);
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Probabilities::Probabilities(const pybind11::capsule &settings, const pybind11::object &data_x,
+              const pybind11::object &data_y, const pybind11::array_t<double> &params, double sample_rate,
+              const pybind11::object &func, const std::string &metric, const size_t batch_size,
+              const std::optional<uint64_t> seed, const bool exhaustive, const RecurrenceMatrix *matrix, const std::optional<bool> tiled,
+              const std::optional<double> tolerance, const std::string &criterion, const size_t min_samples,
+              const std::optional<std::pair<size_t, size_t>> shard) : sample_rate(sample_rate),
+              batch(batch_size), function(func), metric(metric_from_name(metric)), tolerance(tolerance),
+              criterion(criterion_from_name(criterion)), min_samples(min_samples), shard_index(shard ? shard->first : 0),
+              shard_count(shard ? shard->second : 1), data_x(make_data(data_x, data_y)),
+              data_y(make_data(data_y, data_x)),
+              settings(*static_cast<Settings*>(settings.get_pointer())),
+              stencil(this->settings, strides(this->data_x), strides(this->data_y), dimensions(this->data_x)[0]),
+              sampler(this->settings, dimensions(this->data_x), dimensions(this->data_y), sample_rate, seed.value_or(random_seed()),
+                  tiling(this->data_x, this->data_y, tiled), tiling(this->data_y, this->data_x, tiled)) {
+
+    //      Check the input arguments.
+    check_data(this->settings, dimensions(this->data_x), dimensions(this->data_y));
 
-    this->samples.resize(this->settings.available_threads());
-    for (size_t i = 0; i < this->settings.available_threads(); i++) {
-        const auto numb = int_number + (rest_number > 0 ? 1 : 0);
-        this->samples[i].resize(numb);
+    if (shard_count == 0 || shard_index >= shard_count)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: the shard (k, n) must have 0 <= k < n.");
+    if (shard && exhaustive)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Probabilities: a shard can only be taken from the sampled mode.");
 
-        std::vector<size_t> indices(numb);
-        std::iota(indices.begin(), indices.end(), start_index);
+    const auto arguments = numpy_to_vector(params);
+    if (matrix != nullptr) check_matrix(*matrix, arguments);
 
-        for (size_t j = 0; j < numb; j++) this->samples[i][j] = samples[indices[j]];
+    //      The threshold of the built-in recurrence is kept for histogram(), a user function has none.
+    if (func.is_none() && !arguments.empty()) this->threshold = arguments[0];
 
-        start_index += numb;
-        if (rest_number > 0) --rest_number;
-    }
+    if (this->settings.profiling()) this->profiler = std::make_unique<Profiler>(this->settings.available_threads());
 
-    if (this->settings.dictionary()) this->compute_to_dict(numpy_to_vector(params));
-    else this->compute_to_vector(numpy_to_vector(params));
+    //      The counting runs without the GIL, the user function takes it back only for its calls.
+    pybind11::gil_scoped_release release;
+    if (exhaustive) this->compute_exhaustive(arguments, matrix);
+    else this->compute_sampled(arguments, matrix);
 }
+//      -------------------------------------------------------------------------------------------------------
+//              * Explicit instantiations used by the library.
+template std::vector<double> RecurrenceMicrostates::numpy_to_vector(const pybind11::array_t<double> &array);
+//      -------------------------------------------------------------------------------------------------------
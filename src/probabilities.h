@@ -16,52 +16,114 @@
 //      -------------------------------------------------------------------------------------------------------
 //              * Include the libraries that we will use.
 #include <tuple>
+#include <string>
 #include <vector>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <cstdint>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
 #include "tensor.h"
 #include "settings.h"
+#include "stencil.h"
+#include "sampler.h"
+#include "recurrence.h"
+#include "histogram.h"
+#include "matrix.h"
+#include "convergence.h"
+#include "record.h"
+#include "profiler.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Pairs per call of a batched recurrence function, 0 calls the function once per pair.
+#define DEFAULT_CALLBACK_BATCH 0
 //      -------------------------------------------------------------------------------------------------------
 //              * Namespace RecurrenceMicrostates
 namespace RecurrenceMicrostates {
-    //      -------------------------------------------------------------------------------------------------------
-    //              * Default recurrence function
-    inline bool std_recurrence(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &params);
     //      -------------------------------------------------------------------------------------------------------
     //              * Util function to convert a NumPy Array to a std::vector.
     template<typename T> std::vector<T> numpy_to_vector(const pybind11::array_t<T> &array);
     //      -------------------------------------------------------------------------------------------------------
+    //              * Check that data x, data y and the microstate structure are compatible.
+    void check_data(const Settings &settings, const std::vector<size_t> &dims_x, const std::vector<size_t> &dims_y);
+    //      -------------------------------------------------------------------------------------------------------
     //              * Our Probabilities class structure.
     class Probabilities {
-        std::vector<std::vector<std::vector<size_t>>> samples;
-
         const double sample_rate;
-        const pybind11::function function;
-        const Tensor<double> data_x;
-        const Tensor<double> data_y;
+        const size_t batch;
+        const pybind11::object function;
+        const unsigned short metric;
+        const std::optional<double> tolerance;
+        const unsigned short criterion;
+        const size_t min_samples;
+        const size_t shard_index;
+        const size_t shard_count;
+        const Data data_x;
+        const Data data_y;
 
         Settings settings;
+        Stencil stencil;
+        Sampler sampler;
+        std::unique_ptr<Profiler> profiler;
 
         std::vector<double> vect_result;
+        std::vector<size_t> vect_counts;
+        std::vector<uint64_t> dict_keys;
+        std::vector<size_t> dict_counts;
+        double threshold = std::numeric_limits<double>::quiet_NaN();
+        size_t used = 0;
+        bool stopped = false;
 
-        void compute_to_vector(const std::vector<double> &params);
-        void compute_to_dict(const std::vector<double> &params);
-
-        static std::tuple<std::vector<size_t>, size_t> task_compute_using_vector(const std::vector<std::vector<size_t>> &samples,
-            const Settings &settings, const Tensor<double> &data_x, const Tensor<double> &data_y, const std::vector<double> &params,
-            const pybind11::function &function);
+        template<typename Task> void collect(size_t count, size_t chunk, Task &&task);
+        template<typename Task> void collect_samples(size_t count, size_t chunk, Task &&task);
+        template<typename Task> void collect_adaptive(size_t count, size_t chunk, Task &&task);
+        void compute_sampled(const std::vector<double> &params, const RecurrenceMatrix *matrix);
+        void compute_exhaustive(const std::vector<double> &params, const RecurrenceMatrix *matrix);
+        void check_matrix(const RecurrenceMatrix &matrix, const std::vector<double> &params) const;
 
-        static std::vector<double> get_data(const Tensor<double> tensor, const std::vector<size_t> &fixed_indexes,
-            const std::vector<size_t> &recursive_indexes);
+        template<typename T, typename Counter> static size_t task_compute(const Sampler &sampler, size_t begin,
+            size_t end, const Settings &settings, const Stencil &stencil, const Tensor<T> &data_x, const Tensor<T> &data_y,
+            const std::vector<double> &params, const pybind11::object &function, unsigned short metric, size_t batch,
+            Profiler *profiler, Counter &&count);
 
         static bool call_user_function(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &params,
-            const pybind11::function &function);
+            const pybind11::object &function);
+        static void call_user_batch(const std::vector<double> &x, const std::vector<double> &y, size_t pairs, size_t length,
+            const std::vector<double> &params, const pybind11::object &function, std::vector<uint8_t> &recurrent);
+
+        [[nodiscard]] size_t chunk() const;
+        [[nodiscard]] static std::vector<size_t> tiling(const Data &data, const Data &other, std::optional<bool> tiled);
 
     public:
-          explicit Probabilities(const pybind11::capsule &settings, const pybind11::array_t<double> &data_x,
-              const pybind11::array_t<double> &data_y, const pybind11::array_t<double> &params, double sample_rate = 0.2,
-              const pybind11::function &func = pybind11::none());
+          [[nodiscard]] bool dictionary() const { return settings.dictionary(); }
+          [[nodiscard]] uint64_t seed() const { return sampler.seed(); }
+          [[nodiscard]] bool tiled() const { return sampler.tiled(); }
+          [[nodiscard]] size_t samples() const { return used; }
+          [[nodiscard]] bool converged() const { return stopped; }
+
+          //      In the vector mode the probabilities and counts are dense, indexed by the microstate. In the
+          //  dictionary mode they are sparse and follow the microstates of keys(). The arrays are read-only views
+          //  over the results, without a copy.
+          [[nodiscard]] pybind11::array_t<double> probabilities() const;
+          [[nodiscard]] pybind11::array_t<uint64_t> keys() const;
+          [[nodiscard]] pybind11::array_t<size_t> counts() const;
+          [[nodiscard]] HistogramRecord histogram() const;
+
+          //      The counters and timers of the run, only when the settings were created with profile = True.
+          [[nodiscard]] pybind11::dict stats() const;
+          void trace(const std::string &path) const;
+
+          //      The data is read in its own type when data x and data y are both float64, float32, int32, int16 or
+          //  uint8 arrays, otherwise it is converted to float64.
+          explicit Probabilities(const pybind11::capsule &settings, const pybind11::object &data_x,
+              const pybind11::object &data_y, const pybind11::array_t<double> &params, double sample_rate = 0.2,
+              const pybind11::object &func = pybind11::none(), const std::string &metric = DEFAULT_METRIC,
+              size_t batch_size = DEFAULT_CALLBACK_BATCH, std::optional<uint64_t> seed = std::nullopt,
+              bool exhaustive = false, const RecurrenceMatrix *matrix = nullptr, std::optional<bool> tiled = std::nullopt,
+              std::optional<double> tolerance = std::nullopt, const std::string &criterion = DEFAULT_CRITERION,
+              size_t min_samples = ADAPTIVE_MIN_SAMPLES, std::optional<std::pair<size_t, size_t>> shard = std::nullopt);
     };
     //      -------------------------------------------------------------------------------------------------------
 }
@@ -0,0 +1,143 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Profiler .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "profiler.h"
+//                * Include the used libraries.
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+//      -------------------------------------------------------------------------------------------------------
+thread_local unsigned int RecurrenceMicrostates::Profiler::current = 0;
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Profiler::Profiler(const unsigned int workers) : origin(std::chrono::steady_clock::now()),
+    counters(std::max(1u, workers)), events(std::max(1u, workers)) {}
+//      -------------------------------------------------------------------------------------------------------
+const char *RecurrenceMicrostates::Profiler::phase_name(const unsigned short phase) {
+    switch (phase) {
+        case PHASE_COUNT: return "count";
+        case PHASE_CALLBACK: return "callback";
+        case PHASE_REDUCE: return "reduce";
+        case PHASE_NORMALIZE: return "normalize";
+        default: return "unknown";
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Profiler::add(std::vector<Event> &list, const unsigned short phase, const double start,
+    const double end, const size_t samples) {
+    //      The chunks of a worker follow each other with almost no gap, so they are joined into a single event
+    //  and the trace keeps a few events per worker and phase instead of one per chunk.
+    for (auto it = list.rbegin(); it != list.rend(); ++it) {
+        if (it->phase != phase) continue;
+        if (start - it->end < TRACE_MERGE_GAP) {
+            it->end = std::max(it->end, end);
+            it->samples += samples;
+            return;
+        }
+        break;
+    }
+
+    list.push_back({phase, start, end, samples});
+}
+//      -------------------------------------------------------------------------------------------------------
+double RecurrenceMicrostates::Profiler::enter(const unsigned int worker) {
+    current = worker;
+    return now();
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Profiler::record(const unsigned int worker, const unsigned short phase, const double start, const size_t samples) {
+    const auto end = now();
+    auto &counter = counters[worker];
+
+    counter.seconds[phase] += end - start;
+    if (phase == PHASE_COUNT) {
+        counter.samples += samples;
+        counter.evaluations += samples * per_evaluations;
+        counter.bytes += samples * per_bytes;
+        counter.chunks++;
+    }
+
+    add(events[worker], phase, start, end, samples);
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Profiler::callback(const double start) {
+    const auto end = now();
+    auto &counter = counters[current];
+
+    counter.seconds[PHASE_CALLBACK] += end - start;
+    counter.callbacks++;
+    add(events[current], PHASE_CALLBACK, start, end, 0);
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Profiler::phase(const unsigned short phase, const double start) {
+    const auto end = now();
+    walls[phase] += end - start;
+    phases.push_back({phase, start, end, 0});
+}
+//      -------------------------------------------------------------------------------------------------------
+double RecurrenceMicrostates::Profiler::imbalance() const {
+    double busiest = 0.0;
+    double total = 0.0;
+    for (const auto &counter : counters) {
+        busiest = std::max(busiest, counter.seconds[PHASE_COUNT]);
+        total += counter.seconds[PHASE_COUNT];
+    }
+
+    const auto mean = total / static_cast<double>(counters.size());
+    return mean > 0.0 ? busiest / mean : 1.0;
+}
+//      -------------------------------------------------------------------------------------------------------
+std::string RecurrenceMicrostates::Profiler::trace() const {
+    //      Complete ("X") events in microseconds, the workers in the rows 0, ..., n - 1 and the whole phases in
+    //  the row n.
+    std::ostringstream json;
+    json.precision(3);
+    json << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    const auto rows = events.size();
+    bool comma = false;
+    const auto write = [&](const Event &event, const size_t row) {
+        json << (comma ? "," : "") << "\n{\"name\":\"" << phase_name(event.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << row
+             << ",\"ts\":" << event.start * 1e6 << ",\"dur\":" << (event.end - event.start) * 1e6
+             << ",\"args\":{\"samples\":" << event.samples << "}}";
+        comma = true;
+    };
+    const auto name = [&](const size_t row, const std::string &label) {
+        json << (comma ? "," : "") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << row
+             << ",\"args\":{\"name\":\"" << label << "\"}}";
+        comma = true;
+    };
+
+    for (size_t w = 0; w < rows; w++) {
+        name(w, "worker " + std::to_string(w));
+        for (const auto &event : events[w]) write(event, w);
+    }
+
+    name(rows, "phases");
+    for (const auto &event : phases) write(event, rows);
+
+    json << "\n]}\n";
+    return json.str();
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Profiler::write_trace(const std::string &path) const {
+    std::ofstream file(path);
+    if (!file) throw std::invalid_argument("[ERROR] Recurrence Microstates - Profiler: the file '" + path + "' can not be written.");
+
+    file << trace();
+    if (!file) throw std::invalid_argument("[ERROR] Recurrence Microstates - Profiler: the file '" + path + "' can not be written.");
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Profiler header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef PROFILER_H
+#define PROFILER_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "threadpool.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define PHASE_COUNT 0           //  Draw the samples, gather the data and evaluate the recurrences (one fused loop).
+#define PHASE_CALLBACK 1        //  Calls of a Python recurrence function, inside PHASE_COUNT.
+#define PHASE_REDUCE 2          //  Sum or merge of the histograms of the threads.
+#define PHASE_NORMALIZE 3       //  Division of the counts by the number of samples.
+#define PHASES 4
+
+#define TRACE_MERGE_GAP 5e-5    //  Chunks of a thread closer than this (in seconds) are one trace event.
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Profiler class structure.
+    //      The counters and timers of one computation, one set per worker of the pool. Each worker only writes
+    //  its own set, so nothing is locked. The time is taken per chunk of samples, never per sample: the samples
+    //  are drawn, gathered and evaluated in a single loop, which is measured as a whole as PHASE_COUNT.
+    class Profiler {
+    public:
+        struct alignas(CACHE_LINE) Worker {
+            size_t samples = 0;
+            size_t evaluations = 0;
+            size_t callbacks = 0;
+            size_t bytes = 0;
+            size_t chunks = 0;
+            std::array<double, PHASES> seconds{};
+        };
+
+    private:
+        struct Event {
+            unsigned short phase;
+            double start;
+            double end;
+            size_t samples;
+        };
+
+        std::chrono::steady_clock::time_point origin;
+        std::vector<Worker> counters;
+        std::vector<std::vector<Event>> events;
+        std::vector<Event> phases;
+        std::array<double, PHASES> walls{};
+
+        size_t per_evaluations = 0;
+        size_t per_bytes = 0;
+
+        //      The worker of the chunk that runs on this thread, for the callbacks that do not know it.
+        static thread_local unsigned int current;
+
+        static void add(std::vector<Event> &list, unsigned short phase, double start, double end, size_t samples);
+
+    public:
+        [[nodiscard]] double now() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count(); }
+        [[nodiscard]] const std::vector<Worker> &workers() const { return counters; }
+        [[nodiscard]] double wall(const unsigned short phase) const { return walls[phase]; }
+        [[nodiscard]] static const char *phase_name(unsigned short phase);
+
+        //      Recurrences evaluated and bytes loaded by each sample counted, set before the computation.
+        void costs(size_t evaluations, size_t bytes) { per_evaluations = evaluations; per_bytes = bytes; }
+
+        //      A chunk of a worker: enter() marks its start, record() its end with the samples counted.
+        double enter(unsigned int worker);
+        void record(unsigned int worker, unsigned short phase, double start, size_t samples = 0);
+        //      A call of a Python recurrence function on the current worker.
+        void callback(double start);
+        //      A whole phase, as seen by the calling thread.
+        void phase(unsigned short phase, double start);
+
+        //      The busiest worker over the mean of PHASE_COUNT, 1 when the work is even.
+        [[nodiscard]] double imbalance() const;
+
+        //      The events as Chrome trace-event JSON (chrome://tracing or Perfetto), one row per worker.
+        [[nodiscard]] std::string trace() const;
+        void write_trace(const std::string &path) const;
+
+        explicit Profiler(unsigned int workers);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Times a whole phase on the calling thread, when there is a profiler.
+    class ProfilePhase {
+        Profiler *profiler;
+        unsigned short which;
+        double start;
+
+    public:
+        ProfilePhase(Profiler *profiler, const unsigned short phase) : profiler(profiler), which(phase),
+            start(profiler != nullptr ? profiler->now() : 0.0) {}
+        ~ProfilePhase() { if (profiler != nullptr) profiler->phase(which, start); }
+
+        ProfilePhase(const ProfilePhase &) = delete;
+        ProfilePhase &operator=(const ProfilePhase &) = delete;
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
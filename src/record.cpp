@@ -0,0 +1,179 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Histogram record .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "record.h"
+//                * Include the used libraries.
+#include <bit>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Little-endian writes and reads, whatever the byte order of the machine.
+    void put(std::string &out, const uint64_t value, const size_t bytes) {
+        for (size_t b = 0; b < bytes; b++) out.push_back(static_cast<char>(value >> (8 * b) & 0xFF));
+    }
+
+    struct Reader {
+        const std::string &in;
+        size_t at = 0;
+
+        uint64_t get(const size_t bytes) {
+            if (in.size() - at < bytes)
+                throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: the record is truncated.");
+
+            uint64_t value = 0;
+            for (size_t b = 0; b < bytes; b++) value |= static_cast<uint64_t>(static_cast<unsigned char>(in[at + b])) << (8 * b);
+            at += bytes;
+            return value;
+        }
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::HistogramRecord::HistogramRecord(const std::vector<size_t> &structure, const unsigned short metric,
+    const double threshold, const uint64_t samples, const uint64_t seed, const bool sparse, std::vector<uint64_t> keys,
+    std::vector<uint64_t> counts) : shape(structure), kind(metric), limit(threshold), total(samples), key(seed), sparse(sparse),
+    found(std::move(keys)), counted(std::move(counts)) {
+
+    //      Check the input before to keep it.
+    //      A user recurrence function has no threshold, and nothing tells two of them apart.
+    if (std::isnan(limit))
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: a record needs the threshold of a built-in recurrence, a run with a user function cannot be recorded.");
+
+    //      The product stops at 64, so the sizes of damaged bytes cannot overflow it, and a zero size is refused.
+    size_t hypervolume = 1;
+    for (const auto size : shape) {
+        if (size == 0 || hypervolume > 64 / size)
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: the structure must have a hypervolume between 1 and 64.");
+        hypervolume *= size;
+    }
+    if (shape.empty())
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: the structure must have a hypervolume between 1 and 64.");
+
+    if (sparse) {
+        if (found.size() != counted.size() || std::ranges::adjacent_find(found, std::greater_equal()) != found.end())
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: a sparse record needs one count per key, with the keys in ascending order.");
+        if (hypervolume < 64 && !found.empty() && found.back() >> hypervolume != 0)
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: a key is not a microstate of the structure.");
+    } else if (!found.empty() || hypervolume >= 64 || counted.size() != size_t{1} << hypervolume)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: a dense record needs one count per microstate.");
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::HistogramRecord::HistogramRecord(const std::string &bytes) : kind(0), limit(0), total(0), key(0), sparse(false) {
+    Reader reader{bytes};
+    if (bytes.compare(0, 4, RECORD_MAGIC) != 0)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: the bytes are not a histogram record.");
+
+    reader.at = 4;
+    if (reader.get(2) != RECORD_VERSION)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: unknown record version.");
+
+    const bool is_sparse = reader.get(2) != 0;
+    const auto metric = static_cast<unsigned short>(reader.get(2));
+    std::vector<size_t> structure(reader.get(2));
+    for (auto &size : structure) size = reader.get(8);
+
+    const auto threshold = std::bit_cast<double>(reader.get(8));
+    const auto samples = reader.get(8);
+    const auto seed = reader.get(8);
+    const auto entries = reader.get(8);
+    if (entries > (bytes.size() - reader.at) / 8)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: the record is truncated.");
+
+    std::vector<uint64_t> keys(is_sparse ? entries : 0);
+    for (auto &k : keys) k = reader.get(8);
+    std::vector<uint64_t> counts(entries);
+    for (auto &c : counts) c = reader.get(8);
+
+    *this = HistogramRecord(structure, metric, threshold, samples, seed, is_sparse, std::move(keys), std::move(counts));
+}
+//      -------------------------------------------------------------------------------------------------------
+std::string RecurrenceMicrostates::HistogramRecord::bytes() const {
+    std::string out(RECORD_MAGIC);
+    out.reserve(48 + 8 * shape.size() + 8 * (found.size() + counted.size()));
+
+    put(out, RECORD_VERSION, 2);
+    put(out, sparse, 2);
+    put(out, kind, 2);
+    put(out, shape.size(), 2);
+    for (const auto size : shape) put(out, size, 8);
+
+    put(out, std::bit_cast<uint64_t>(limit), 8);
+    put(out, total, 8);
+    put(out, key, 8);
+    put(out, counted.size(), 8);
+    for (const auto k : found) put(out, k, 8);
+    for (const auto c : counted) put(out, c, 8);
+
+    return out;
+}
+//      -------------------------------------------------------------------------------------------------------
+std::vector<double> RecurrenceMicrostates::HistogramRecord::probabilities() const {
+    const auto scale = total > 0 ? static_cast<double>(total) : 1.0;
+
+    std::vector<double> result(counted.size());
+    for (size_t i = 0; i < counted.size(); i++) result[i] = static_cast<double>(counted[i]) / scale;
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::HistogramRecord RecurrenceMicrostates::HistogramRecord::merge(const HistogramRecord &other) const {
+    if (shape != other.shape || kind != other.kind || limit != other.limit)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - HistogramRecord: only records of the same structure, metric and threshold can be merged.");
+
+    //      Records of different seeds give a mixed seed, which stays mixed in any further merge.
+    const auto seed = key == other.key ? key : RECORD_MIXED_SEED;
+    const auto samples = total + other.total;
+
+    //      Two sparse records: merge the keys in order.
+    if (sparse && other.sparse) {
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> counts;
+        keys.reserve(found.size() + other.found.size());
+        counts.reserve(found.size() + other.found.size());
+
+        size_t a = 0, b = 0;
+        while (a < found.size() || b < other.found.size()) {
+            if (b == other.found.size() || (a < found.size() && found[a] < other.found[b])) {
+                keys.push_back(found[a]);
+                counts.push_back(counted[a++]);
+            } else if (a == found.size() || other.found[b] < found[a]) {
+                keys.push_back(other.found[b]);
+                counts.push_back(other.counted[b++]);
+            } else {
+                keys.push_back(found[a]);
+                counts.push_back(counted[a++] + other.counted[b++]);
+            }
+        }
+
+        return {shape, kind, limit, samples, seed, true, std::move(keys), std::move(counts)};
+    }
+
+    //      Otherwise the result is dense, the sparse counts are scattered into it.
+    const auto &dense = sparse ? other : *this;
+    const auto &rest = sparse ? *this : other;
+
+    std::vector<uint64_t> counts(dense.counted);
+    if (rest.sparse) for (size_t i = 0; i < rest.found.size(); i++) counts[rest.found[i]] += rest.counted[i];
+    else for (size_t i = 0; i < counts.size(); i++) counts[i] += rest.counted[i];
+
+    return {shape, kind, limit, samples, seed, false, {}, std::move(counts)};
+}
+//      -------------------------------------------------------------------------------------------------------
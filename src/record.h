@@ -0,0 +1,73 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Histogram record header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef RECORD_H
+#define RECORD_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define RECORD_MAGIC "MRPH"
+#define RECORD_VERSION 1
+#define RECORD_MIXED_SEED 0xFFFFFFFFFFFFFFFFull    //  Seed of a record merged from runs with different seeds.
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our HistogramRecord class structure.
+    //      The exact counts of a run with what is needed to combine it with others: the structure, the metric,
+    //  the threshold, the number of samples and the seed. The counts are dense (one per microstate) or sparse (the
+    //  microstates found, in ascending order). merge() adds the counts of records of the same structure, metric
+    //  and threshold, and it is associative and commutative, so the shards of an analysis can be combined in any
+    //  order. The bytes are little-endian:
+    //
+    //      "MRPH" | version u16 | sparse u16 | metric u16 | dimensions u16 | structure u64[dimensions]
+    //      | threshold f64 | samples u64 | seed u64 | entries u64 | keys u64[entries] (sparse) | counts u64[entries]
+    class HistogramRecord {
+        std::vector<size_t> shape;
+        unsigned short kind;
+        double limit;
+        uint64_t total;
+        uint64_t key;
+
+        bool sparse;
+        std::vector<uint64_t> found;
+        std::vector<uint64_t> counted;
+
+    public:
+        [[nodiscard]] const std::vector<size_t> &structure() const { return shape; }
+        [[nodiscard]] unsigned short metric() const { return kind; }
+        [[nodiscard]] double threshold() const { return limit; }
+        [[nodiscard]] uint64_t samples() const { return total; }
+        [[nodiscard]] uint64_t seed() const { return key; }
+        [[nodiscard]] bool dictionary() const { return sparse; }
+        [[nodiscard]] const std::vector<uint64_t> &keys() const { return found; }
+        [[nodiscard]] const std::vector<uint64_t> &counts() const { return counted; }
+
+        [[nodiscard]] std::vector<double> probabilities() const;
+        [[nodiscard]] std::string bytes() const;
+        [[nodiscard]] HistogramRecord merge(const HistogramRecord &other) const;
+
+        //      A sparse record has the microstates found in keys, in ascending order, and their counts. A dense one
+        //  has no keys and one count per microstate. The threshold cannot be NaN, the one of a user function.
+        HistogramRecord(const std::vector<size_t> &structure, unsigned short metric, double threshold, uint64_t samples,
+            uint64_t seed, bool sparse, std::vector<uint64_t> keys, std::vector<uint64_t> counts);
+        explicit HistogramRecord(const std::string &bytes);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
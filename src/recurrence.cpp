@@ -0,0 +1,497 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Recurrence .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "recurrence.h"
+//                * Include the used libraries.
+#include <cmath>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RECURRENCE_X86
+#include <immintrin.h>
+#endif
+//      -------------------------------------------------------------------------------------------------------
+//              * Instruction sets that we can dispatch to.
+#define ISA_SCALAR 0
+#define ISA_AVX2 1
+#define ISA_AVX512 2
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Accumulate one component of the distance.
+    template<unsigned short M, typename A> A accumulate(const A acc, const A diff) {
+        if constexpr (M == METRIC_EUCLIDEAN) return acc + diff * diff;
+        else if constexpr (M == METRIC_CHEBYSHEV) return std::max(acc, diff < 0 ? -diff : diff);
+        else return acc + (diff < 0 ? -diff : diff);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Distance of one cell, L is the vector length when known at compile time (0 otherwise).
+    template<unsigned short M, size_t L, typename T = double>
+    RecurrenceMicrostates::Accumulator<T> scalar_distance(const T *x, const std::ptrdiff_t step_x, const T *y,
+        const std::ptrdiff_t step_y, const size_t length) {
+
+        using A = RecurrenceMicrostates::Accumulator<T>;
+        const size_t n = L == 0 ? length : L;
+        A distance = 0;
+        for (size_t k = 0; k < n; k++)
+            distance = accumulate<M>(distance, static_cast<A>(x[static_cast<std::ptrdiff_t>(k) * step_x]) -
+                static_cast<A>(y[static_cast<std::ptrdiff_t>(k) * step_y]));
+
+        return distance;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Scalar kernels.
+    template<unsigned short M, size_t L, typename T = double>
+    uint64_t scalar_kernel(const T *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const T *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, const RecurrenceMicrostates::Accumulator<T> threshold) {
+
+        uint64_t bits = 0;
+        for (size_t m = 0; m < cells; m++)
+            bits |= static_cast<uint64_t>(scalar_distance<M, L>(x + offsets_x[m], step_x, y + offsets_y[m], step_y, length) <= threshold) << m;
+
+        return bits;
+    }
+
+    //      The integer data with a threshold below one: every component must be equal, whatever the metric.
+    template<size_t L, typename T>
+    uint64_t equal_kernel(const T *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const T *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, RecurrenceMicrostates::Accumulator<T>) {
+
+        const size_t n = L == 0 ? length : L;
+        uint64_t bits = 0;
+        for (size_t m = 0; m < cells; m++) {
+            const auto *px = x + offsets_x[m];
+            const auto *py = y + offsets_y[m];
+
+            bool equal = true;
+            for (size_t k = 0; k < n; k++)
+                equal &= px[static_cast<std::ptrdiff_t>(k) * step_x] == py[static_cast<std::ptrdiff_t>(k) * step_y];
+
+            bits |= static_cast<uint64_t>(equal) << m;
+        }
+
+        return bits;
+    }
+
+    template<unsigned short M, size_t L>
+    void scalar_distances(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, double *distances) {
+
+        for (size_t m = 0; m < cells; m++)
+            distances[m] = scalar_distance<M, L>(x + offsets_x[m], step_x, y + offsets_y[m], step_y, length);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+#ifdef RECURRENCE_X86
+    //              * AVX2: four cells at a time, each lane gathers its own cell.
+    template<unsigned short M, size_t L>
+    __attribute__((target("avx2,fma"), always_inline)) inline
+    __m256d avx2_distance(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t length) {
+
+        const size_t n = L == 0 ? length : L;
+        const auto sign = _mm256_set1_pd(-0.0);
+        const auto next_x = _mm256_set1_epi64x(step_x);
+        const auto next_y = _mm256_set1_epi64x(step_y);
+
+        auto index_x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(offsets_x));
+        auto index_y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(offsets_y));
+
+        auto distance = _mm256_setzero_pd();
+        for (size_t k = 0; k < n; k++) {
+            const auto diff = _mm256_sub_pd(_mm256_i64gather_pd(x, index_x, 8), _mm256_i64gather_pd(y, index_y, 8));
+
+            if constexpr (M == METRIC_EUCLIDEAN) distance = _mm256_fmadd_pd(diff, diff, distance);
+            else if constexpr (M == METRIC_CHEBYSHEV) distance = _mm256_max_pd(distance, _mm256_andnot_pd(sign, diff));
+            else distance = _mm256_add_pd(distance, _mm256_andnot_pd(sign, diff));
+
+            index_x = _mm256_add_epi64(index_x, next_x);
+            index_y = _mm256_add_epi64(index_y, next_y);
+        }
+
+        return distance;
+    }
+
+    template<unsigned short M, size_t L>
+    __attribute__((target("avx2,fma")))
+    uint64_t avx2_kernel(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, const double threshold) {
+
+        const auto limit = _mm256_set1_pd(threshold);
+
+        uint64_t bits = 0;
+        size_t m = 0;
+        for (; m + 4 <= cells; m += 4) {
+            const auto distance = avx2_distance<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, length);
+            bits |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(distance, limit, _CMP_LE_OQ))) << m;
+        }
+
+        if (m < cells)
+            bits |= scalar_kernel<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, cells - m, length, threshold) << m;
+        return bits;
+    }
+
+    template<unsigned short M, size_t L>
+    __attribute__((target("avx2,fma")))
+    void avx2_distances(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, double *distances) {
+
+        size_t m = 0;
+        for (; m + 4 <= cells; m += 4)
+            _mm256_storeu_pd(distances + m, avx2_distance<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, length));
+
+        scalar_distances<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, cells - m, length, distances + m);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * AVX-512: eight cells at a time.
+    template<unsigned short M, size_t L>
+    __attribute__((target("avx512f"), always_inline)) inline
+    __m512d avx512_distance(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t length) {
+
+        const size_t n = L == 0 ? length : L;
+        const auto next_x = _mm512_set1_epi64(step_x);
+        const auto next_y = _mm512_set1_epi64(step_y);
+
+        auto index_x = _mm512_loadu_si512(offsets_x);
+        auto index_y = _mm512_loadu_si512(offsets_y);
+
+        auto distance = _mm512_setzero_pd();
+        for (size_t k = 0; k < n; k++) {
+            //      The masked forms take an explicit source, the plain ones leave it undefined and GCC warns about it.
+            const auto diff = _mm512_sub_pd(_mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, index_x, x, 8),
+                _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, index_y, y, 8));
+
+            if constexpr (M == METRIC_EUCLIDEAN) distance = _mm512_fmadd_pd(diff, diff, distance);
+            else if constexpr (M == METRIC_CHEBYSHEV) distance = _mm512_mask_max_pd(distance, 0xFF, distance, _mm512_abs_pd(diff));
+            else distance = _mm512_add_pd(distance, _mm512_abs_pd(diff));
+
+            index_x = _mm512_add_epi64(index_x, next_x);
+            index_y = _mm512_add_epi64(index_y, next_y);
+        }
+
+        return distance;
+    }
+
+    template<unsigned short M, size_t L>
+    __attribute__((target("avx512f")))
+    uint64_t avx512_kernel(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, const double threshold) {
+
+        const auto limit = _mm512_set1_pd(threshold);
+
+        uint64_t bits = 0;
+        size_t m = 0;
+        for (; m + 8 <= cells; m += 8) {
+            const auto distance = avx512_distance<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, length);
+            bits |= static_cast<uint64_t>(_mm512_cmp_pd_mask(distance, limit, _CMP_LE_OQ)) << m;
+        }
+
+        if (m < cells)
+            bits |= scalar_kernel<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, cells - m, length, threshold) << m;
+        return bits;
+    }
+
+    template<unsigned short M, size_t L>
+    __attribute__((target("avx512f")))
+    void avx512_distances(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, double *distances) {
+
+        size_t m = 0;
+        for (; m + 8 <= cells; m += 8)
+            _mm512_storeu_pd(distances + m, avx512_distance<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, length));
+
+        scalar_distances<M, L>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, cells - m, length, distances + m);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * AVX2 lanes of eight cells, loaded one by one: the value at offsets[c] + shift of each cell c.
+    template<typename T>
+    __attribute__((target("avx2"), always_inline)) inline
+    auto avx2_lanes(const T *data, const std::ptrdiff_t *offsets, const std::ptrdiff_t shift) {
+        if constexpr (std::is_same_v<T, float>)
+            return _mm256_setr_ps(data[offsets[0] + shift], data[offsets[1] + shift], data[offsets[2] + shift], data[offsets[3] + shift],
+                data[offsets[4] + shift], data[offsets[5] + shift], data[offsets[6] + shift], data[offsets[7] + shift]);
+        else
+            return _mm256_setr_epi32(data[offsets[0] + shift], data[offsets[1] + shift], data[offsets[2] + shift], data[offsets[3] + shift],
+                data[offsets[4] + shift], data[offsets[5] + shift], data[offsets[6] + shift], data[offsets[7] + shift]);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * AVX2 for float32: eight cells at a time. The lanes are loaded one by one, a gather of four
+    //  floats was slower than the scalar kernel on the CPUs we measured.
+    template<unsigned short M, size_t L>
+    __attribute__((target("avx2,fma")))
+    uint64_t avx2_float_kernel(const float *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const float *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, const float threshold) {
+
+        const size_t n = L == 0 ? length : L;
+        const auto sign = _mm256_set1_ps(-0.0f);
+        const auto limit = _mm256_set1_ps(threshold);
+
+        uint64_t bits = 0;
+        size_t m = 0;
+        for (; m + 8 <= cells; m += 8) {
+            auto distance = _mm256_setzero_ps();
+            for (size_t k = 0; k < n; k++) {
+                const auto diff = _mm256_sub_ps(avx2_lanes(x, offsets_x + m, static_cast<std::ptrdiff_t>(k) * step_x),
+                    avx2_lanes(y, offsets_y + m, static_cast<std::ptrdiff_t>(k) * step_y));
+
+                if constexpr (M == METRIC_EUCLIDEAN) distance = _mm256_fmadd_ps(diff, diff, distance);
+                else if constexpr (M == METRIC_CHEBYSHEV) distance = _mm256_max_ps(distance, _mm256_andnot_ps(sign, diff));
+                else distance = _mm256_add_ps(distance, _mm256_andnot_ps(sign, diff));
+            }
+
+            bits |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(distance, limit, _CMP_LE_OQ))) << m;
+        }
+
+        //      The scalar tail is SSE code: with the upper halves of the registers still dirty, each of its
+        //  instructions would pay for a merge.
+        _mm256_zeroupper();
+        if (m < cells)
+            bits |= scalar_kernel<M, L, float>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, cells - m, length, threshold) << m;
+        return bits;
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * AVX2 for int16 and uint8: eight cells at a time in 32 bits lanes.
+    //      There is no gather of 8 or 16 bits (and a 32 bits gather would read past the data), so the lanes are
+    //  loaded one by one. The distances must fit in 32 bits (see narrow_fits), except the Euclidean one of int16,
+    //  whose squares are summed in 64 bits: the even and the odd lanes apart.
+    template<unsigned short M, size_t L, typename T>
+    __attribute__((target("avx2")))
+    uint64_t avx2_integer_kernel(const T *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+        const T *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells,
+        const size_t length, const int64_t threshold) {
+
+        constexpr bool wide = M == METRIC_EUCLIDEAN && sizeof(T) == 2;
+        const size_t n = L == 0 ? length : L;
+        const auto limit = _mm256_set1_epi32(static_cast<int32_t>(std::min<int64_t>(threshold, std::numeric_limits<int32_t>::max())));
+        const auto limit_wide = _mm256_set1_epi64x(threshold);
+
+        uint64_t bits = 0;
+        size_t m = 0;
+        for (; m + 8 <= cells; m += 8) {
+            auto distance = _mm256_setzero_si256();
+            auto odd = _mm256_setzero_si256();
+            for (size_t k = 0; k < n; k++) {
+                const auto diff = _mm256_sub_epi32(avx2_lanes(x, offsets_x + m, static_cast<std::ptrdiff_t>(k) * step_x),
+                    avx2_lanes(y, offsets_y + m, static_cast<std::ptrdiff_t>(k) * step_y));
+
+                if constexpr (wide) {
+                    distance = _mm256_add_epi64(distance, _mm256_mul_epi32(diff, diff));
+                    const auto high = _mm256_srli_epi64(diff, 32);
+                    odd = _mm256_add_epi64(odd, _mm256_mul_epi32(high, high));
+                } else if constexpr (M == METRIC_EUCLIDEAN) distance = _mm256_add_epi32(distance, _mm256_mullo_epi32(diff, diff));
+                else if constexpr (M == METRIC_CHEBYSHEV) distance = _mm256_max_epi32(distance, _mm256_abs_epi32(diff));
+                else distance = _mm256_add_epi32(distance, _mm256_abs_epi32(diff));
+            }
+
+            uint64_t above;
+            if constexpr (wide) {
+                //      Bit c of each mask is the lane 2c (even) or 2c + 1 (odd), interleaved back in the lane order.
+                const auto even_mask = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(distance, limit_wide))));
+                const auto odd_mask = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(odd, limit_wide))));
+                above = 0;
+                for (size_t c = 0; c < 4; c++) above |= (even_mask >> c & 1) << 2 * c | (odd_mask >> c & 1) << (2 * c + 1);
+            } else above = static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(distance, limit))));
+
+            bits |= (~above & 0xFF) << m;
+        }
+
+        if (m < cells)
+            bits |= scalar_kernel<M, L, T>(x, offsets_x + m, step_x, y, offsets_y + m, step_y, cells - m, length, threshold) << m;
+        return bits;
+    }
+#endif
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Find the best instruction set available, only once per process.
+    int instruction_set() {
+#ifdef RECURRENCE_X86
+        static const int isa = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return ISA_AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return ISA_AVX2;
+            return ISA_SCALAR;
+        }();
+        return isa;
+#else
+        return ISA_SCALAR;
+#endif
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The two families of kernels: microstate bits and cell distances.
+    struct Bits {
+        using Kernel = RecurrenceMicrostates::RecurrenceKernel;
+        template<unsigned short M, size_t L> static Kernel scalar() { return scalar_kernel<M, L>; }
+#ifdef RECURRENCE_X86
+        template<unsigned short M, size_t L> static Kernel avx2() { return avx2_kernel<M, L>; }
+        template<unsigned short M, size_t L> static Kernel avx512() { return avx512_kernel<M, L>; }
+#endif
+    };
+
+    struct Distances {
+        using Kernel = RecurrenceMicrostates::DistanceKernel;
+        template<unsigned short M, size_t L> static Kernel scalar() { return scalar_distances<M, L>; }
+#ifdef RECURRENCE_X86
+        template<unsigned short M, size_t L> static Kernel avx2() { return avx2_distances<M, L>; }
+        template<unsigned short M, size_t L> static Kernel avx512() { return avx512_distances<M, L>; }
+#endif
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    template<typename K, unsigned short M, size_t L> typename K::Kernel select_isa() {
+#ifdef RECURRENCE_X86
+        switch (instruction_set()) {
+            case ISA_AVX512: return K::template avx512<M, L>();
+            case ISA_AVX2: return K::template avx2<M, L>();
+            default: break;
+        }
+#endif
+        return K::template scalar<M, L>();
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Dispatch on the vector length, the usual embedding dimensions get their own kernel.
+    template<typename K, unsigned short M> typename K::Kernel select_length(const size_t length) {
+        switch (length) {
+            case 1: return select_isa<K, M, 1>();
+            case 2: return select_isa<K, M, 2>();
+            case 3: return select_isa<K, M, 3>();
+            default: return select_isa<K, M, 0>();
+        }
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    template<typename K> typename K::Kernel select_kernel(const unsigned short metric, const size_t length) {
+        switch (metric) {
+            case METRIC_EUCLIDEAN: return select_length<K, METRIC_EUCLIDEAN>(length);
+            case METRIC_CHEBYSHEV: return select_length<K, METRIC_CHEBYSHEV>(length);
+            case METRIC_MANHATTAN: return select_length<K, METRIC_MANHATTAN>(length);
+            default: throw std::invalid_argument("[ERROR] Recurrence Microstates - Recurrence: unknown metric.");
+        }
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The kernels of the other data types, with the same dispatch on the metric and the length.
+    //      The distances of the 32 bits lanes of the int16 and uint8 AVX2 kernel must fit in them. The Euclidean
+    //  distance of int16 is summed in 64 bits, so it always fits.
+    template<typename T, unsigned short M> bool narrow_fits(const size_t length) {
+        if constexpr (M == METRIC_CHEBYSHEV || (M == METRIC_EUCLIDEAN && sizeof(T) == 2)) return true;
+
+        const auto component = static_cast<uint64_t>(std::numeric_limits<T>::max()) - static_cast<uint64_t>(std::numeric_limits<T>::min());
+        const auto largest = M == METRIC_EUCLIDEAN ? component * component : component;
+        return length <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max()) / largest;
+    }
+
+    template<typename T, unsigned short M, size_t L> RecurrenceMicrostates::TypedRecurrenceKernel<T> select_typed_isa(const size_t length) {
+#ifdef RECURRENCE_X86
+        if (instruction_set() != ISA_SCALAR) {
+            if constexpr (std::is_same_v<T, float>) return avx2_float_kernel<M, L>;
+            if constexpr (std::is_same_v<T, int16_t> || std::is_same_v<T, uint8_t>)
+                if (narrow_fits<T, M>(length)) return avx2_integer_kernel<M, L, T>;
+        }
+#endif
+        return scalar_kernel<M, L, T>;
+    }
+
+    template<typename T, unsigned short M> RecurrenceMicrostates::TypedRecurrenceKernel<T> select_typed_length(const size_t length) {
+        switch (length) {
+            case 1: return select_typed_isa<T, M, 1>(length);
+            case 2: return select_typed_isa<T, M, 2>(length);
+            case 3: return select_typed_isa<T, M, 3>(length);
+            default: return select_typed_isa<T, M, 0>(length);
+        }
+    }
+
+    template<typename T> RecurrenceMicrostates::TypedRecurrenceKernel<T> select_typed(const unsigned short metric, const size_t length,
+        const RecurrenceMicrostates::Accumulator<T> threshold) {
+        if constexpr (std::is_integral_v<T>) {
+            if (threshold == 0 && metric <= METRIC_MANHATTAN) {
+                //      A zero Chebyshev distance is the equality, which the AVX2 kernel of the narrow types checks too.
+                if constexpr (sizeof(T) <= 2)
+                    if (instruction_set() != ISA_SCALAR) return select_typed_length<T, METRIC_CHEBYSHEV>(length);
+
+                switch (length) {
+                    case 1: return equal_kernel<1, T>;
+                    case 2: return equal_kernel<2, T>;
+                    case 3: return equal_kernel<3, T>;
+                    default: return equal_kernel<0, T>;
+                }
+            }
+        }
+
+        switch (metric) {
+            case METRIC_EUCLIDEAN: return select_typed_length<T, METRIC_EUCLIDEAN>(length);
+            case METRIC_CHEBYSHEV: return select_typed_length<T, METRIC_CHEBYSHEV>(length);
+            case METRIC_MANHATTAN: return select_typed_length<T, METRIC_MANHATTAN>(length);
+            default: throw std::invalid_argument("[ERROR] Recurrence Microstates - Recurrence: unknown metric.");
+        }
+    }
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The threshold in the type of the distances, an integer distance is below t when it is below floor(t).
+    template<typename T> RecurrenceMicrostates::Accumulator<T> typed_threshold(const unsigned short metric, const double threshold) {
+        using A = RecurrenceMicrostates::Accumulator<T>;
+        const auto scaled = RecurrenceMicrostates::scale_threshold(metric, threshold);
+        if constexpr (std::is_integral_v<T>) {
+            //      Far above any distance of the type, and exact in the accumulator.
+            const auto largest = sizeof(A) > sizeof(int64_t) ? 1e36 : static_cast<double>(std::numeric_limits<int64_t>::max() / 2);
+            if (scaled < 0) return -1;
+            return static_cast<A>(std::floor(std::min(scaled, largest)));
+        } else return static_cast<T>(scaled);
+    }
+    //      -------------------------------------------------------------------------------------------------------
+}
+//      -------------------------------------------------------------------------------------------------------
+unsigned short RecurrenceMicrostates::metric_from_name(const std::string &name) {
+    if (name == "euclidean") return METRIC_EUCLIDEAN;
+    if (name == "chebyshev" || name == "maximum") return METRIC_CHEBYSHEV;
+    if (name == "manhattan" || name == "cityblock") return METRIC_MANHATTAN;
+
+    throw std::invalid_argument("[ERROR] Recurrence Microstates - Recurrence: unknown metric '" + name + "', use 'euclidean', 'chebyshev' or 'manhattan'.");
+}
+//      -------------------------------------------------------------------------------------------------------
+double RecurrenceMicrostates::scale_threshold(const unsigned short metric, const double threshold) {
+    //      The Euclidean distance is compared squared. A negative threshold never recurs, so we keep it negative.
+    if (metric == METRIC_EUCLIDEAN) return threshold < 0 ? -1.0 : threshold * threshold;
+    return threshold;
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::BasicRecurrence<T>::BasicRecurrence(const unsigned short metric, const double threshold, const size_t length,
+    const ShapeKernels *kernels) : kernel(nullptr), threshold(typed_threshold<T>(metric, threshold)), length(length) {
+
+    //      The shape specialized kernels are written for float64, the other types have their own vectorized kernels.
+    if constexpr (std::is_same_v<T, double>) {
+        kernel = select_kernel<Bits>(metric, length);
+        if (kernels != nullptr) shape = length == 1 ? kernels->scalar[metric] : kernels->vector[metric];
+    } else kernel = select_typed<T>(metric, length, this->threshold);
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Distance::Distance(const unsigned short metric, const size_t length)
+    : kernel(select_kernel<Distances>(metric, length)), metric(metric), length(length) {
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Explicit instantiations used by the library.
+template class RecurrenceMicrostates::BasicRecurrence<double>;
+template class RecurrenceMicrostates::BasicRecurrence<float>;
+template class RecurrenceMicrostates::BasicRecurrence<int32_t>;
+template class RecurrenceMicrostates::BasicRecurrence<int16_t>;
+template class RecurrenceMicrostates::BasicRecurrence<uint8_t>;
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Recurrence header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef RECURRENCE_H
+#define RECURRENCE_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "kernels.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define METRIC_EUCLIDEAN 0
+#define METRIC_CHEBYSHEV 1
+#define METRIC_MANHATTAN 2
+
+#define DEFAULT_METRIC "euclidean"
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * The type in which the distances of a data type are computed: the integers are exact in 64 bits,
+    //  or 128 bits for int32, whose squared differences reach 2^64. float32 stays in single precision.
+    template<typename T> using Accumulator = std::conditional_t<std::is_integral_v<T>,
+        std::conditional_t<sizeof(T) >= sizeof(int32_t), __int128, int64_t>, T>;
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A recurrence kernel evaluates a set of cells and returns their recurrences as bits, where the
+    //  cell m compares the vectors starting at x + offsets_x[m] and y + offsets_y[m].
+    template<typename T> using TypedRecurrenceKernel = uint64_t (*)(const T *x, const std::ptrdiff_t *offsets_x, std::ptrdiff_t step_x,
+        const T *y, const std::ptrdiff_t *offsets_y, std::ptrdiff_t step_y, size_t cells, size_t length, Accumulator<T> threshold);
+    using RecurrenceKernel = TypedRecurrenceKernel<double>;
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A distance kernel writes the distance of each cell, in the scale of scale_threshold.
+    using DistanceKernel = void (*)(const double *x, const std::ptrdiff_t *offsets_x, std::ptrdiff_t step_x,
+        const double *y, const std::ptrdiff_t *offsets_y, std::ptrdiff_t step_y, size_t cells, size_t length, double *distances);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Convert a threshold to the scale in which the kernels compare it (squared for Euclidean).
+    double scale_threshold(unsigned short metric, double threshold);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Convert a metric name ("euclidean", "chebyshev" or "manhattan") to its define.
+    unsigned short metric_from_name(const std::string &name);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Recurrence class structure.
+    //      It selects, at runtime, the best kernel for the CPU (AVX-512, AVX2 or scalar), the metric and the vector
+    //  length. The Euclidean threshold is kept squared, so no square root is taken. When the Settings has kernels
+    //  specialized for its shape, the matching one is selected too.
+    //      The data of other types (float32, int32, int16 and uint8) is read as it is, without converting it to
+    //  float64. For the integers the threshold is rounded down to an integer, and a threshold below one becomes
+    //  the exact equality of the vectors.
+    template<typename T> class BasicRecurrence {
+        TypedRecurrenceKernel<T> kernel;
+        MicrostateKernel shape = nullptr;
+        Accumulator<T> threshold;
+        size_t length;
+
+    public:
+        [[nodiscard]] size_t vector_size() const { return length; }
+        [[nodiscard]] bool specialized() const { return shape != nullptr; }
+
+        //      Whole microstate from the x and y patches, only available when specialized() is true.
+        [[nodiscard]] uint64_t microstate(const T *x, const std::ptrdiff_t *patch_x, const std::ptrdiff_t step_x,
+            const T *y, const std::ptrdiff_t *patch_y, const std::ptrdiff_t step_y) const {
+            if constexpr (std::is_same_v<T, double>) return shape(x, patch_x, step_x, y, patch_y, step_y, length, threshold);
+            else return 0;
+        }
+
+        [[nodiscard]] uint64_t operator()(const T *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x,
+            const T *y, const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells) const {
+            return kernel(x, offsets_x, step_x, y, offsets_y, step_y, cells, length, threshold);
+        }
+
+        BasicRecurrence(unsigned short metric, double threshold, size_t length, const ShapeKernels *kernels = nullptr);
+    };
+
+    using Recurrence = BasicRecurrence<double>;
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Distance class structure.
+    //      The same dispatch of Recurrence, but it gives the distance of each cell instead of comparing it, so one
+    //  evaluation can be compared with many thresholds (already given by scale()).
+    class Distance {
+        DistanceKernel kernel;
+        unsigned short metric;
+        size_t length;
+
+    public:
+        [[nodiscard]] size_t vector_size() const { return length; }
+        [[nodiscard]] double scale(const double threshold) const { return scale_threshold(metric, threshold); }
+
+        void operator()(const double *x, const std::ptrdiff_t *offsets_x, const std::ptrdiff_t step_x, const double *y,
+            const std::ptrdiff_t *offsets_y, const std::ptrdiff_t step_y, const size_t cells, double *distances) const {
+            kernel(x, offsets_x, step_x, y, offsets_y, step_y, cells, length, distances);
+        }
+
+        Distance(unsigned short metric, size_t length);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
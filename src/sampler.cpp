@@ -0,0 +1,129 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Sampler .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "sampler.h"
+//                * Include the used libraries.
+#include <cmath>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+//      -------------------------------------------------------------------------------------------------------
+uint64_t RecurrenceMicrostates::random_seed() {
+    std::random_device rd;
+    return static_cast<uint64_t>(rd()) << 32 | rd();
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Sampler::Sampler(const Settings &settings, const std::vector<size_t> &dims_x,
+    const std::vector<size_t> &dims_y, const double sample_rate, const uint64_t seed,
+    const std::vector<size_t> &tile_x, const std::vector<size_t> &tile_y) : count(0), key(seed) {
+
+    const auto dims = dims_x.size() - 1;
+    if (dims_y.size() != dims_x.size() || settings.dimensions() != 2 * dims)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Sampler: the configured microstate structure and the given data are not compatible.");
+
+    //      Compute the recurrence space hypervolume and the number of samples to take.
+    const auto hypervolume = std::accumulate(dims_x.begin() + 1, dims_x.end(), size_t{1}, std::multiplies()) *
+                             std::accumulate(dims_y.begin() + 1, dims_y.end(), size_t{1}, std::multiplies());
+    this->count = static_cast<size_t>(std::floor(static_cast<double>(hypervolume) * sample_rate));
+
+    //      Number of positions of the microstate along each dimension, [x dimensions..., y dimensions...].
+    this->ranges.resize(2 * dims);
+    for (size_t dim = 0; dim < dims; dim++) {
+        if (dims_x[dim + 1] < settings.structure(dim) || dims_y[dim + 1] < settings.structure(dims + dim))
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - Sampler: the microstate structure is larger than the data.");
+
+        this->ranges[dim] = dims_x[dim + 1] - settings.structure(dim) + 1;
+        this->ranges[dims + dim] = dims_y[dim + 1] - settings.structure(dims + dim) + 1;
+    }
+
+    this->tiles = this->ranges;
+    if (tile_x.size() > dims || tile_y.size() > dims)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Sampler: there are more tile lengths than dimensions of the data.");
+
+    //      The tiled dimensions, a zero length keeps the whole dimension as a single tile. The pairs are walked
+    //  with the y tile outside and the x tile inside, each one with its first dimension inside.
+    for (size_t dim = 0; dim < tile_x.size(); dim++)
+        if (tile_x[dim] > 0) this->tiles[dim] = std::min<uint64_t>(tile_x[dim], this->ranges[dim]);
+    for (size_t dim = 0; dim < tile_y.size(); dim++)
+        if (tile_y[dim] > 0) this->tiles[dims + dim] = std::min<uint64_t>(tile_y[dim], this->ranges[dims + dim]);
+
+    unsigned __int128 below = 1;
+    for (size_t d = 0; d < 2 * dims; d++) {
+        if (this->tiles[d] == this->ranges[d]) continue;
+
+        this->levels.insert(this->levels.begin(), {d, (this->ranges[d] - 1) / this->tiles[d], below, static_cast<double>(below)});
+        below *= this->ranges[d];
+    }
+
+    this->area = below;
+    this->area_estimate = static_cast<double>(below);
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Sampler::tile(const size_t i, size_t *first, unsigned __int128 &low, unsigned __int128 &high) const {
+    //      Walking the pairs in order, the pair k takes the samples [covered(k) * count / area, ...), where covered(k)
+    //  is the area of the pairs before it. The pair of i is the last one with covered(k) * count < (i + 1) * area,
+    //  found one level at a time: at each level a step of the tile index covers unit = length * (area of one tile
+    //  of the levels above) * (range of the levels below), in units of count.
+    const auto target = static_cast<unsigned __int128>(i + 1) * area;
+    auto rest = target;
+    unsigned __int128 above = count;
+
+    //      The same walk in floating point gives the estimates, the integer loops correct them by a step or two.
+    auto rest_estimate = static_cast<double>(i + 1) * area_estimate;
+    auto above_estimate = static_cast<double>(count);
+
+    for (const auto &[d, last, below, below_estimate] : levels) {
+        const auto unit = tiles[d] * below * above;
+        const auto unit_estimate = static_cast<double>(tiles[d]) * below_estimate * above_estimate;
+
+        auto k = static_cast<uint64_t>(std::clamp(rest_estimate / unit_estimate, 0.0, static_cast<double>(last)));
+        while (k < last && (k + 1) * unit < rest) k++;
+        while (k > 0 && k * unit >= rest) k--;
+
+        rest_estimate -= static_cast<double>(k) * unit_estimate;
+        rest -= k * unit;
+        first[d] = k * tiles[d];
+        const auto length = std::min<uint64_t>(tiles[d], ranges[d] - first[d]);
+        above *= length;
+        above_estimate *= static_cast<double>(length);
+    }
+
+    //      The pair takes (i + 1) * area in (covered * count, (covered + its area) * count], above is its area * count.
+    low = target - rest;
+    high = low + above;
+}
+//      -------------------------------------------------------------------------------------------------------
+std::vector<size_t> RecurrenceMicrostates::tile_lengths(const std::vector<size_t> &dims, const size_t element_size) {
+    //      The points a tile can hold. A dimension is kept whole while the ones after it still get TILE_MIN_LINES
+    //  positions each, so the lines in memory stay contiguous (strips of a series or of a narrow image). Otherwise
+    //  the points left are shared evenly among the dimensions left (blocks of a wide image or of a volume).
+    auto points = static_cast<double>(std::max<size_t>(1, TILE_BYTES / (dims[0] * element_size)));
+
+    std::vector<size_t> lengths(dims.size() - 1);
+    for (size_t dim = 0; dim < lengths.size(); dim++) {
+        const auto left = static_cast<double>(lengths.size() - dim - 1);
+        const auto length = static_cast<double>(dims[dim + 1]);
+        const auto side = length * std::pow(TILE_MIN_LINES, left) <= points ? length : std::floor(std::pow(points, 1.0 / (left + 1)) + 1e-9);
+
+        lengths[dim] = std::clamp<size_t>(static_cast<size_t>(side), 1, dims[dim + 1]);
+        points = std::max(1.0, points / static_cast<double>(lengths[dim]));
+    }
+
+    return lengths;
+}
+//      -------------------------------------------------------------------------------------------------------
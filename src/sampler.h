@@ -0,0 +1,159 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Sampler header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef SAMPLER_H
+#define SAMPLER_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "settings.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Philox 4x32 constants (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC 2011).
+#define PHILOX_ROUNDS 10
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+//              * Tiled sampling: the bytes of an x tile and of a y tile (together they stay in L2), the size of the
+//      data from which the tiled order is taken by default, and the fewest lines a tile keeps along each dimension
+//      of a field after the ones that it keeps whole.
+#define TILE_BYTES 131072
+#define TILE_AUTO_BYTES 67108864
+#define TILE_MIN_LINES 8
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Sampler class structure.
+    //      It draws the samples of the recurrence space on demand with a counter-based generator (Philox4x32-10):
+    //  the sample i is a pure function of (seed, i), so the threads produce their samples independently, nothing is
+    //  stored and the result of a given seed does not depend on the number of threads.
+    //      In the tiled order the spatial dimensions of x and of y are cut in tiles (strips of a series, blocks of
+    //  an image or a volume), and the samples are split among the (x tile, y tile) pairs in proportion to their
+    //  area: the samples of a chunk fall in one pair, whose data stays in cache, and the pairs are walked along x,
+    //  so the pages of a mapped file are read in sequence. The pair of a sample is found by arithmetic on the tile
+    //  lengths, so there is no table of the pairs, whatever their number.
+    class Sampler {
+        std::vector<uint64_t> ranges;
+        size_t count;
+        uint64_t key;
+
+        //      A tiled dimension d, with the index of its last tile and the area of the whole levels below it.
+        struct Level {
+            size_t d;
+            uint64_t last;
+            unsigned __int128 below;
+            double below_estimate;
+        };
+
+        std::vector<uint64_t> tiles;
+        std::vector<Level> levels;
+        unsigned __int128 area = 0;
+        double area_estimate = 0;
+
+        //      Maps 64 random bits to [0, range) by a multiply-high, the bias is below range / 2^64.
+        [[nodiscard]] static size_t bounded(const uint64_t bits, const uint64_t range) {
+            return static_cast<size_t>((static_cast<unsigned __int128>(bits) * range) >> 64);
+        }
+
+        //      Draws the index along d inside the tile that starts at first (the whole range when d is not tiled).
+        [[nodiscard]] size_t draw(const size_t d, const size_t first, const uint64_t bits) const {
+            return first + bounded(bits, std::min<uint64_t>(tiles[d], ranges[d] - first));
+        }
+
+        //      Writes the first position of the tile of the sample i along each tiled dimension, and the bounds
+        //  (low, high] of (i + 1) * area for the samples of the same pair.
+        void tile(size_t i, size_t *first, unsigned __int128 &low, unsigned __int128 &high) const;
+
+        //      Draws the sample i inside the tile whose first positions are already in sample. Each generator call
+        //  gives 128 bits, enough for two indexes.
+        void draw(const size_t i, size_t *sample) const {
+            for (size_t d = 0; d < ranges.size(); d += 2) {
+                const auto bits = philox({static_cast<uint32_t>(i), static_cast<uint32_t>(static_cast<uint64_t>(i) >> 32),
+                    static_cast<uint32_t>(d), 0}, key);
+
+                sample[d] = draw(d, sample[d], static_cast<uint64_t>(bits[0]) << 32 | bits[1]);
+                if (d + 1 < ranges.size()) sample[d + 1] = draw(d + 1, sample[d + 1], static_cast<uint64_t>(bits[2]) << 32 | bits[3]);
+            }
+        }
+
+    public:
+        //      The Philox4x32-10 block of the counter under the key, whose low 32 bits are the first key word.
+        [[nodiscard]] static std::array<uint32_t, 4> philox(std::array<uint32_t, 4> counter, uint64_t key) {
+            auto k0 = static_cast<uint32_t>(key);
+            auto k1 = static_cast<uint32_t>(key >> 32);
+
+            for (int round = 0; round < PHILOX_ROUNDS; round++) {
+                const auto p0 = static_cast<uint64_t>(PHILOX_M0) * counter[0];
+                const auto p1 = static_cast<uint64_t>(PHILOX_M1) * counter[2];
+                counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ k0, static_cast<uint32_t>(p1),
+                           static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ k1, static_cast<uint32_t>(p0)};
+                k0 += PHILOX_W0;
+                k1 += PHILOX_W1;
+            }
+
+            return counter;
+        }
+
+        //      The tile of the last sample drawn by a thread. The samples of a chunk are mostly in the same pair, so
+        //  it is only found again when a sample leaves it.
+        struct Cursor {
+            std::vector<size_t> first;
+            unsigned __int128 low = 0;
+            unsigned __int128 high = 0;
+        };
+
+        [[nodiscard]] size_t size() const { return count; }
+        [[nodiscard]] size_t dimensions() const { return ranges.size(); }
+        [[nodiscard]] uint64_t seed() const { return key; }
+        [[nodiscard]] bool tiled() const { return !levels.empty(); }
+        [[nodiscard]] Cursor cursor() const { return {std::vector<size_t>(ranges.size(), 0)}; }
+
+        //      Writes the sample i as the D = dimensions() values [x indexes..., y indexes...].
+        void operator()(const size_t i, size_t *sample) const {
+            auto cursor = this->cursor();
+            (*this)(i, sample, cursor);
+        }
+
+        //      The same sample, reusing the tile of the cursor when i is in it.
+        void operator()(const size_t i, size_t *sample, Cursor &cursor) const {
+            if (!levels.empty()) {
+                const auto target = static_cast<unsigned __int128>(i + 1) * area;
+                if (target <= cursor.low || target > cursor.high) tile(i, cursor.first.data(), cursor.low, cursor.high);
+            }
+
+            std::copy(cursor.first.begin(), cursor.first.end(), sample);
+            draw(i, sample);
+        }
+
+        //      The dimensions include the first (vector) dimension, exactly as a Tensor stores them. The tiles are
+        //  given as positions along each spatial dimension of x and y, a 0 or a missing length keeps the whole
+        //  dimension, so no tiles draw the samples over the whole space.
+        Sampler(const Settings &settings, const std::vector<size_t> &dims_x, const std::vector<size_t> &dims_y,
+            double sample_rate, uint64_t seed, const std::vector<size_t> &tile_x = {}, const std::vector<size_t> &tile_y = {});
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Tile lengths along the spatial dimensions of a tensor, so that a tile takes about TILE_BYTES: a
+    //  strip of a series or of whole lines of a field when they fit, otherwise a block about as long on every side.
+    std::vector<size_t> tile_lengths(const std::vector<size_t> &dims, size_t element_size);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A seed for the runs without one given by the user.
+    uint64_t random_seed();
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
@@ -0,0 +1,66 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Scan .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "scan.h"
+//                * Include the used libraries.
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+void RecurrenceMicrostates::BasicScan<T>::row(const size_t j, uint64_t *bits) const {
+    const auto *y = data_y + static_cast<std::ptrdiff_t>(j) * stride_y;
+
+    for (size_t first = 0, w = 0; first < size_x; first += SCAN_WORD, w++) {
+        const auto *x = data_x + static_cast<std::ptrdiff_t>(first) * stride_x;
+        bits[w] = recurrence(x, word_x.data(), step_x, y, word_y.data(), step_y, std::min<size_t>(SCAN_WORD, size_x - first));
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::BasicScan<T>::BasicScan(const Settings &settings, const T *data_x, const std::vector<size_t> &dims_x,
+    const std::vector<std::ptrdiff_t> &strides_x, const T *data_y, const std::vector<size_t> &dims_y,
+    const std::vector<std::ptrdiff_t> &strides_y, const BasicRecurrence<T> &recurrence) : data_x(data_x), data_y(data_y),
+    word_x(SCAN_WORD), word_y(SCAN_WORD, 0), top(0), recurrence(recurrence) {
+
+    //      Check the input before to do anything.
+    if (dims_x.size() != 2 || dims_y.size() != 2 || settings.dimensions() != 2)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Scan: the exhaustive mode requires time series, with a two dimensional structure.");
+    if (dims_x[0] != dims_y[0])
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Scan: data x and data y first dimension must have the same size.");
+    if (dims_x[1] < settings.patch_x() || dims_y[1] < settings.patch_y())
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Scan: the microstate structure is larger than the data.");
+
+    size_x = dims_x[1];
+    size_y = dims_y[1];
+    patch_x = settings.patch_x();
+    patch_y = settings.patch_y();
+
+    step_x = strides_x[0];
+    step_y = strides_y[0];
+    stride_x = strides_x[1];
+    stride_y = strides_y[1];
+
+    for (size_t m = 0; m < SCAN_WORD; m++) word_x[m] = static_cast<std::ptrdiff_t>(m) * stride_x;
+    for (size_t b = 0; b < patch_y; b++) top |= uint64_t{1} << (b * patch_x + patch_x - 1);
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Explicit instantiations used by the library.
+template class RecurrenceMicrostates::BasicScan<double>;
+template class RecurrenceMicrostates::BasicScan<float>;
+template class RecurrenceMicrostates::BasicScan<int32_t>;
+template class RecurrenceMicrostates::BasicScan<int16_t>;
+template class RecurrenceMicrostates::BasicScan<uint8_t>;
+//      -------------------------------------------------------------------------------------------------------
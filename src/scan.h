@@ -0,0 +1,106 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Scan header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef SCAN_H
+#define SCAN_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "settings.h"
+#include "recurrence.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define SCAN_CHUNK 16           //  Rows of the recurrence plot per task, each task recomputes patch_y - 1 rows.
+#define SCAN_WORD 64
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Scan class structure.
+    //      It counts every microstate of the recurrence plot of two time series, walking it row by row. A task
+    //  keeps the last patch_y rows of the plot bit-packed (64 recurrences per word, computed by the same kernels
+    //  as the microstates) and slides a register along them: each step shifts the microstate by one column and
+    //  only reads the patch_y bits of the new one. So each recurrence is evaluated once per task, instead of once
+    //  for each of the hypervolume microstates that contain it.
+    template<typename T> class BasicScan {
+        const T *data_x;
+        const T *data_y;
+
+        size_t size_x;
+        size_t size_y;
+        size_t patch_x;
+        size_t patch_y;
+
+        std::ptrdiff_t stride_x;
+        std::ptrdiff_t stride_y;
+        std::ptrdiff_t step_x;
+        std::ptrdiff_t step_y;
+
+        //      The x offsets of the 64 recurrences of a word, all against the same y point.
+        std::vector<std::ptrdiff_t> word_x;
+        std::vector<std::ptrdiff_t> word_y;
+
+        //      The highest bit of each group of patch_x bits, where the new column goes.
+        uint64_t top;
+        BasicRecurrence<T> recurrence;
+
+        //      Row j of the plot: the recurrences of all the x points with the y point j.
+        void row(size_t j, uint64_t *bits) const;
+
+    public:
+        [[nodiscard]] size_t rows() const { return size_y - patch_y + 1; }
+        [[nodiscard]] size_t columns() const { return size_x - patch_x + 1; }
+        [[nodiscard]] size_t size() const { return rows() * columns(); }
+
+        //      Count the microstates of the rows [begin, end), it returns how many were counted.
+        template<typename Counter> size_t operator()(const size_t begin, const size_t end, Counter &&count) const {
+            const auto words = (size_x + SCAN_WORD - 1) / SCAN_WORD;
+
+            //      A ring with the patch_y rows under the register, the row j is at j % patch_y.
+            std::vector<uint64_t> band(patch_y * words);
+            const auto ring = [&](const size_t j) { return band.data() + (j % patch_y) * words; };
+
+            for (auto j = begin; j + 1 < begin + patch_y; j++) row(j, ring(j));
+
+            std::vector<const uint64_t *> lines(patch_y);
+            for (auto j = begin; j < end; j++) {
+                row(j + patch_y - 1, ring(j + patch_y - 1));
+                for (size_t b = 0; b < patch_y; b++) lines[b] = ring(j + b);
+
+                uint64_t microstate = 0;
+                for (size_t c = 0; c < size_x; c++) {
+                    microstate = (microstate >> 1) & ~top;
+                    for (size_t b = 0; b < patch_y; b++)
+                        microstate |= (lines[b][c / SCAN_WORD] >> (c % SCAN_WORD) & 1) << (b * patch_x + patch_x - 1);
+
+                    if (c + 1 >= patch_x) count(microstate);
+                }
+            }
+
+            return (end - begin) * columns();
+        }
+
+        //      The data are time series, the dimensions and strides are given as a Tensor stores them: the first
+        //  (vector) dimension and the time.
+        BasicScan(const Settings &settings, const T *data_x, const std::vector<size_t> &dims_x, const std::vector<std::ptrdiff_t> &strides_x,
+            const T *data_y, const std::vector<size_t> &dims_y, const std::vector<std::ptrdiff_t> &strides_y, const BasicRecurrence<T> &recurrence);
+    };
+
+    using Scan = BasicScan<double>;
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
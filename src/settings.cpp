@@ -17,16 +17,26 @@
 #include <vector>
 #include <thread>
 #include <numeric>
+#include <algorithm>
+#include <stdexcept>
 #include <iostream>
 //      -------------------------------------------------------------------------------------------------------
-RecurrenceMicrostates::Settings::Settings(const std::vector<size_t> &structure, const unsigned int threads, const unsigned short mode) {
+RecurrenceMicrostates::Settings::Settings(const std::vector<size_t> &structure, const unsigned int threads, const unsigned short mode,
+    const size_t dictionary_threshold, const bool profile) {
     //      Check the input before to do anything.
     if (structure.size() < 2) throw std::invalid_argument("[ERROR] Recurrence Microstates - Settings: the microstate structure required at least two dimensions.");
+    if (structure.size() % 2 != 0) throw std::invalid_argument("[ERROR] Recurrence Microstates - Settings: the microstate structure must have the same number of dimensions for x and y.");
+    if (std::ranges::find(structure, 0) != structure.end()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Settings: the microstate structure cannot have an empty dimension.");
 
     //      Save the information.
     this->threads = threads;
+    this->profile = profile;
     this->shape = structure;
-    this->hypervolume = std::accumulate(structure.begin(), structure.end(), 1, std::multiplies());
+    this->hypervolume = std::accumulate(structure.begin(), structure.end(), size_t{1}, std::multiplies());
+
+    //      Number of points of the x and y patches of a microstate.
+    this->volume_x = std::accumulate(structure.begin(), structure.begin() + static_cast<std::ptrdiff_t>(structure.size() / 2), size_t{1}, std::multiplies());
+    this->volume_y = hypervolume / volume_x;
 
     //      Check the number of threads.
     if (threads < 1) {
@@ -35,14 +45,42 @@ RecurrenceMicrostates::Settings::Settings(const std::vector<size_t> &structure,
     } else if (threads > std::thread::hardware_concurrency())
         std::cout << "[WARNING] Recurrence Microstates - Settings: the number of configured threads exceeds the number available on the hardware. This configuration may affect library performance." << std::endl;
 
+    //      All the Settings share the process-wide thread pool, it only grows when more threads are asked.
+    this->workers = ThreadPool::instance(this->threads);
+
     //      Since we are using Python, the hypervolume of our microstate cannot exceed 64.
     if (this->hypervolume > 64) throw std::invalid_argument("[ERROR] Recurrence Microstates - Settings: the hypervolume of the microstates exceeds 64, and this library does not support it.");
 
-    //      Check the use of dictionaries.
-    this->use_dictionary = mode == MODE_FORCE_DICTIONARY;
-    this->use_dictionary = hypervolume > DEFAULT_HYPERVOLUME_TO_DICTIONARY ? true : this->use_dictionary;
-    this->use_dictionary = mode == MODE_FORCE_VECTOR ? false : this->use_dictionary;
+    //      Check the use of dictionaries. The default threshold comes from benchmarks/histogram.cpp, it is the
+    //  hypervolume from which the hash histogram is faster than allocating and reducing the dense vectors.
+    this->mode = mode;
+    this->dictionary_bits = dictionary_threshold;
+    this->use_dictionary = this->dictionary(hypervolume);
 
     //      Compute the power vector.
     for (size_t i = 0; i < hypervolume; i++) vect.push_back(static_cast<size_t>(pow(2, i)));
-}
\ No newline at end of file
+
+    //      Select the kernels specialized for this shape, if any. Otherwise, the generic stencil path is used.
+    this->kernels = shape_kernels(volume_x, volume_y);
+
+    //      Compute the stencil: the relative index of each cell inside the microstate, with the first
+    //  dimension running faster. The bit m of a microstate is the recurrence of the cell m.
+    std::vector<size_t> indexes(structure.size(), 0);
+    cells.reserve(hypervolume * structure.size());
+    for (size_t m = 0; m < hypervolume; m++) {
+        cells.insert(cells.end(), indexes.begin(), indexes.end());
+
+        for (size_t k = 0; k < structure.size(); k++) {
+            if (++indexes[k] < structure[k]) break;
+            indexes[k] = 0;
+        }
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+bool RecurrenceMicrostates::Settings::dictionary(const size_t bits) const {
+    //      Whether a histogram of 2^bits entries is counted in a dictionary, with the same mode and threshold
+    //  that decided it for the microstates.
+    if (mode == MODE_FORCE_VECTOR) return false;
+    return mode == MODE_FORCE_DICTIONARY || bits > dictionary_bits;
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -15,8 +15,13 @@
 #define SETTINGS_H
 //      -------------------------------------------------------------------------------------------------------
 //              * Include the libraries that we will use.
+#include <cmath>
+#include <memory>
 #include <thread>
 #include <vector>
+
+#include "kernels.h"
+#include "threadpool.h"
 //      -------------------------------------------------------------------------------------------------------
 //              * Defines
 #define MODE_DEFAULT 0
@@ -24,7 +29,7 @@
 #define MODE_FORCE_DICTIONARY 2
 
 #define DEFAULT_THREADS 1
-#define DEFAULT_HYPERVOLUME_TO_DICTIONARY 26
+#define DEFAULT_HYPERVOLUME_TO_DICTIONARY 22      //  From benchmarks/histogram.cpp: count_sparse wins from 23 bits (1M samples, 1-4 threads).
 //      -------------------------------------------------------------------------------------------------------
 //              * Namespace RecurrenceMicrostates
 namespace RecurrenceMicrostates {
@@ -34,21 +39,40 @@ namespace RecurrenceMicrostates {
 
         std::vector<size_t> vect;
         std::vector<size_t> shape;
+        std::vector<size_t> cells;
 
         size_t hypervolume;
+        size_t volume_x;
+        size_t volume_y;
+        const ShapeKernels *kernels;
+        std::shared_ptr<ThreadPool> workers;
         unsigned int threads;
+        unsigned short mode;
+        size_t dictionary_bits;
         bool use_dictionary;
+        bool profile;
 
     public:
         [[nodiscard]] unsigned int available_threads() const { return threads; }
         [[nodiscard]] size_t dimensions() const { return shape.size(); }
         [[nodiscard]] size_t structure(const size_t dim) const { return shape[dim]; }
         [[nodiscard]] size_t get_hypervolume() const { return hypervolume; }
+        [[nodiscard]] size_t patch_x() const { return volume_x; }
+        [[nodiscard]] size_t patch_y() const { return volume_y; }
+        [[nodiscard]] const ShapeKernels *specialization() const { return kernels; }
+        [[nodiscard]] ThreadPool &pool() const { return *workers; }
         [[nodiscard]] size_t power(const size_t dim) const { return vect[dim]; }
         [[nodiscard]] size_t possibilities() const { return static_cast<size_t>(std::pow(2, hypervolume)); }
         [[nodiscard]] bool dictionary() const { return use_dictionary; }
+        [[nodiscard]] bool dictionary(size_t bits) const;
+        [[nodiscard]] bool profiling() const { return profile; }
+
+        //      Relative index of each microstate cell, in the order of its bit. The cell m uses the
+        //  dimensions() values starting at cells[m * dimensions()].
+        [[nodiscard]] const std::vector<size_t> &stencil() const { return cells; }
 
-        explicit Settings(const std::vector<size_t> &structure, unsigned int threads = std::thread::hardware_concurrency(), unsigned short mode = MODE_DEFAULT);
+        explicit Settings(const std::vector<size_t> &structure, unsigned int threads = std::thread::hardware_concurrency(), unsigned short mode = MODE_DEFAULT,
+            size_t dictionary_threshold = DEFAULT_HYPERVOLUME_TO_DICTIONARY, bool profile = false);
     };
     //      -------------------------------------------------------------------------------------------------------
 }
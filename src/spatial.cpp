@@ -0,0 +1,139 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Spatial .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "spatial.h"
+//                * Include the used libraries.
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+size_t RecurrenceMicrostates::BasicSpatial<T>::row_of(size_t line) const {
+    //      The lines are the x positions of all the dimensions but the last, the second to last running faster.
+    size_t row = 0;
+    size_t scale = 1;
+    for (auto d = points_x.size(); d-- > 0;) {
+        row += line % ranges_x[d] * scale;
+        line /= ranges_x[d];
+        scale *= points_x[d];
+    }
+
+    return row;
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+std::ptrdiff_t RecurrenceMicrostates::BasicSpatial<T>::point_x(size_t row) const {
+    std::ptrdiff_t index = 0;
+    for (auto d = points_x.size(); d-- > 0;) {
+        index += static_cast<std::ptrdiff_t>(row % points_x[d]) * steps_x[d];
+        row /= points_x[d];
+    }
+
+    return index;
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+std::ptrdiff_t RecurrenceMicrostates::BasicSpatial<T>::point_y(size_t position) const {
+    std::ptrdiff_t index = 0;
+    for (auto d = ranges_y.size(); d-- > 0;) {
+        index += static_cast<std::ptrdiff_t>(position % ranges_y[d]) * steps_y[d];
+        position /= ranges_y[d];
+    }
+
+    return index;
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+void RecurrenceMicrostates::BasicSpatial<T>::plane(const T *y, const size_t low, const size_t height, uint64_t *bits) const {
+    const auto last = steps_x.back();
+
+    for (auto row = low; row < low + height; row++) {
+        const auto *x = data_x + point_x(row);
+        for (size_t first = 0; first < size_last; first += SCAN_WORD, x += SCAN_WORD * last)
+            *bits++ = recurrence(x, word_x.data(), step_x, y, word_y.data(), step_y, std::min<size_t>(SCAN_WORD, size_last - first));
+
+        *bits++ = 0;
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::BasicSpatial<T>::BasicSpatial(const Settings &settings, const T *data_x, const std::vector<size_t> &dims_x,
+    const std::vector<std::ptrdiff_t> &strides_x, const T *data_y, const std::vector<size_t> &dims_y,
+    const std::vector<std::ptrdiff_t> &strides_y, const BasicRecurrence<T> &recurrence) : data_x(data_x), data_y(data_y),
+    word_x(SCAN_WORD), word_y(SCAN_WORD, 0), recurrence(recurrence) {
+
+    //      Check the input before to do anything.
+    if (dims_x.size() != dims_y.size() || dims_x.size() < 3 || dims_x.size() > 4 || settings.dimensions() != 2 * (dims_x.size() - 1))
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Spatial: the spatial mode requires 2-D or 3-D data, with a structure of the same dimensions.");
+    if (dims_x[0] != dims_y[0])
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Spatial: data x and data y first dimension must have the same size.");
+
+    const auto dims = dims_x.size() - 1;
+    for (size_t d = 0; d < dims; d++) {
+        if (dims_x[d + 1] < settings.structure(d) || dims_y[d + 1] < settings.structure(dims + d))
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - Spatial: the microstate structure is larger than the data.");
+
+        ranges_x.push_back(dims_x[d + 1] - settings.structure(d) + 1);
+        ranges_y.push_back(dims_y[d + 1] - settings.structure(dims + d) + 1);
+    }
+
+    step_x = strides_x[0];
+    step_y = strides_y[0];
+    steps_x.assign(strides_x.begin() + 1, strides_x.end());
+    steps_y.assign(strides_y.begin() + 1, strides_y.end());
+    points_x.assign(dims_x.begin() + 1, dims_x.end() - 1);
+
+    size_last = dims_x.back();
+    words = (size_last + SCAN_WORD - 1) / SCAN_WORD;
+    lines = std::accumulate(ranges_x.begin(), ranges_x.end() - 1, size_t{1}, std::multiplies());
+    positions = std::accumulate(ranges_y.begin(), ranges_y.end(), size_t{1}, std::multiplies());
+    for (size_t m = 0; m < SCAN_WORD; m++) word_x[m] = static_cast<std::ptrdiff_t>(m) * steps_x.back();
+
+    //      The next line of a block only brings one more row of x points, the block takes the lines whose rows fit
+    //  in SPATIAL_BLOCK_BYTES.
+    const auto line_bytes = dims_x[0] * size_last * sizeof(T);
+    block = std::clamp<size_t>(SPATIAL_BLOCK_BYTES / std::max<size_t>(1, line_bytes), 1, lines);
+
+    //      The cell m compares an x point and a y point of the patches, with its bit in the 64 positions of a word
+    //  taken from the bit row of the y point and the x point row, shifted by the x point along the last dimension.
+    hypervolume = settings.get_hypervolume();
+    const auto &stencil = settings.stencil();
+    for (size_t m = 0; m < hypervolume; m++) {
+        const auto *cell = stencil.data() + m * settings.dimensions();
+
+        std::ptrdiff_t offset_y = 0;
+        for (size_t d = 0; d < dims; d++) offset_y += static_cast<std::ptrdiff_t>(cell[dims + d]) * steps_y[d];
+
+        auto q = static_cast<size_t>(std::ranges::find(offsets_y, offset_y) - offsets_y.begin());
+        if (q == offsets_y.size()) offsets_y.push_back(offset_y);
+
+        size_t row = 0;
+        for (size_t d = 0; d < points_x.size(); d++) row = row * points_x[d] + cell[d];
+
+        cell_q.push_back(q);
+        cell_row.push_back(row);
+        cell_shift.push_back(cell[dims - 1]);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Explicit instantiations used by the library.
+template class RecurrenceMicrostates::BasicSpatial<double>;
+template class RecurrenceMicrostates::BasicSpatial<float>;
+template class RecurrenceMicrostates::BasicSpatial<int32_t>;
+template class RecurrenceMicrostates::BasicSpatial<int16_t>;
+template class RecurrenceMicrostates::BasicSpatial<uint8_t>;
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,183 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Spatial header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef SPATIAL_H
+#define SPATIAL_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "settings.h"
+#include "recurrence.h"
+#include "scan.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define SPATIAL_BLOCK_BYTES 262144      //  x data of a block of lines, it stays in L2 while every y position goes over it.
+#define SPATIAL_POSITIONS 8             //  y positions per task, the next ones reuse the bit rows of their common y points.
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Spatial class structure.
+    //      It counts every microstate of two 2-D or 3-D fields (images, volumes). A row is one y position and one
+    //  line of x positions along the last dimension, and the rows are walked in blocks of lines: for a y position,
+    //  the recurrences of the x points of the block with each y point of the patch are evaluated once, 64 at a
+    //  time along the last dimension, into bit rows as in Scan. The microstates of each line are then read from
+    //  these bits 64 positions at a time, by a transpose of the 64 x 64 bit matrix of their cells. So each
+    //  recurrence is evaluated about once per block, instead of once for each of the hypervolume microstates that
+    //  contain it, and the x data of a block stays in the cache while every y position goes over it.
+    template<typename T> class BasicSpatial {
+        const T *data_x;
+        const T *data_y;
+
+        std::vector<size_t> ranges_x;
+        std::vector<size_t> ranges_y;
+        std::vector<size_t> points_x;
+        std::vector<std::ptrdiff_t> steps_x;
+        std::vector<std::ptrdiff_t> steps_y;
+        std::ptrdiff_t step_x;
+        std::ptrdiff_t step_y;
+
+        size_t lines;
+        size_t positions;
+        size_t block;
+        size_t size_last;
+        size_t words;
+
+        //      The x offsets of the 64 recurrences of a word along the last dimension, all against the same y point.
+        std::vector<std::ptrdiff_t> word_x;
+        std::vector<std::ptrdiff_t> word_y;
+
+        //      For each cell m of the microstate: the y point, the x point row after the line and the position
+        //  along the last dimension.
+        size_t hypervolume;
+        std::vector<std::ptrdiff_t> offsets_y;
+        std::vector<size_t> cell_q;
+        std::vector<size_t> cell_row;
+        std::vector<size_t> cell_shift;
+        BasicRecurrence<T> recurrence;
+
+        //      The x point row of the first point of a line, and the linear index of a point row and of a y position.
+        [[nodiscard]] size_t row_of(size_t line) const;
+        [[nodiscard]] std::ptrdiff_t point_x(size_t row) const;
+        [[nodiscard]] std::ptrdiff_t point_y(size_t position) const;
+
+        //      The bit rows of the x point rows [low, low + height) with a y point, each one followed by a zero word.
+        void plane(const T *y, size_t low, size_t height, uint64_t *bits) const;
+
+        //      In place transpose of a 64 x 64 bit matrix, the bit i of the word m goes to the bit m of the word i.
+        static void transpose(uint64_t *bits) {
+            uint64_t mask = 0x00000000FFFFFFFFull;
+            for (size_t j = 32; j != 0; j >>= 1, mask ^= mask << j)
+                for (size_t k = 0; k < SCAN_WORD; k = (k + j + 1) & ~j) {
+                    const auto swap = ((bits[k] >> j) ^ bits[k + j]) & mask;
+                    bits[k] ^= swap << j;
+                    bits[k + j] ^= swap;
+                }
+        }
+
+    public:
+        [[nodiscard]] size_t rows() const { return lines * positions; }
+        [[nodiscard]] size_t columns() const { return ranges_x.back(); }
+        [[nodiscard]] size_t size() const { return rows() * columns(); }
+        //      Rows per task, so that a task takes the lines of a block for SPATIAL_POSITIONS y positions.
+        [[nodiscard]] size_t chunk() const { return block * SPATIAL_POSITIONS; }
+
+        //      Count the microstates of the rows [begin, end), it returns how many were counted. The row r is in
+        //  the block r / (block * positions), which walks its lines for each y position.
+        template<typename Counter> size_t operator()(const size_t begin, const size_t end, Counter &&count) const {
+            const auto span = block * positions;
+
+            //      The bit rows of the block are kept in slots, tagged by their y point: the next y position along
+            //  the last dimension finds most of its y points already evaluated.
+            const auto slots = 2 * offsets_y.size();
+            const auto unused = std::numeric_limits<std::ptrdiff_t>::min();
+            std::vector<uint64_t> bits;
+            std::vector<std::ptrdiff_t> tags(slots, unused);
+            std::vector<size_t> slot(offsets_y.size());
+            std::vector<const uint64_t *> cell(hypervolume);
+            uint64_t block_bits[SCAN_WORD];
+
+            auto cached_block = static_cast<size_t>(-1);
+            auto cached_position = static_cast<size_t>(-1);
+            size_t low = 0;
+            size_t height = 0;
+
+            for (auto r = begin; r < end; r++) {
+                const auto first = r / span * block;
+                const auto width = std::min(block, lines - first);
+                const auto rest = r - first * positions;
+                const auto position = rest / width;
+                const auto line = first + rest % width;
+
+                if (first != cached_block) {
+                    cached_block = first;
+                    cached_position = static_cast<size_t>(-1);
+                    low = row_of(first);
+                    height = row_of(first + width - 1) + cell_row.back() - low + 1;
+                    bits.resize(slots * height * (words + 1));
+                    std::ranges::fill(tags, unused);
+                }
+
+                if (position != cached_position) {
+                    cached_position = position;
+                    const auto base = point_y(position);
+
+                    for (size_t q = 0; q < offsets_y.size(); q++)
+                        slot[q] = static_cast<size_t>(std::ranges::find(tags, base + offsets_y[q]) - tags.begin());
+
+                    for (size_t q = 0, free = 0; q < offsets_y.size(); q++) {
+                        if (slot[q] < slots) continue;
+                        while (std::ranges::find(slot, free) != slot.end()) free++;
+
+                        slot[q] = free;
+                        tags[free] = base + offsets_y[q];
+                        plane(data_y + tags[free], low, height, bits.data() + free * height * (words + 1));
+                    }
+                }
+
+                const auto row = row_of(line) - low;
+                for (size_t m = 0; m < hypervolume; m++) cell[m] = bits.data() + (slot[cell_q[m]] * height + row + cell_row[m]) * (words + 1);
+
+                //      The microstates of 64 positions at a time: the word m has the bit m of each of them, and a
+                //  transpose gives the microstates.
+                for (size_t at = 0, w = 0; at < columns(); at += SCAN_WORD, w++) {
+                    for (size_t m = 0; m < hypervolume; m++) {
+                        const auto s = cell_shift[m];
+                        block_bits[m] = s == 0 ? cell[m][w] : cell[m][w] >> s | cell[m][w + 1] << (SCAN_WORD - s);
+                    }
+                    std::fill(block_bits + hypervolume, block_bits + SCAN_WORD, 0);
+                    transpose(block_bits);
+
+                    const auto stop = std::min<size_t>(SCAN_WORD, columns() - at);
+                    for (size_t i = 0; i < stop; i++) count(block_bits[i]);
+                }
+            }
+
+            return (end - begin) * columns();
+        }
+
+        //      The data are (vector, d1, d2) or (vector, d1, d2, d3) fields, the dimensions and strides are given as
+        //  a Tensor stores them.
+        BasicSpatial(const Settings &settings, const T *data_x, const std::vector<size_t> &dims_x, const std::vector<std::ptrdiff_t> &strides_x,
+            const T *data_y, const std::vector<size_t> &dims_y, const std::vector<std::ptrdiff_t> &strides_y, const BasicRecurrence<T> &recurrence);
+    };
+
+    using Spatial = BasicSpatial<double>;
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
@@ -0,0 +1,58 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Stencil .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "stencil.h"
+//                * Include the used libraries.
+#include <vector>
+#include <stdexcept>
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Stencil::Stencil(const Settings &settings, const std::vector<std::ptrdiff_t> &strides_x,
+    const std::vector<std::ptrdiff_t> &strides_y, const size_t length) : length(length) {
+
+    //      Check the input before to do anything.
+    if (strides_x.size() != strides_y.size() || 2 * (strides_x.size() - 1) != settings.dimensions())
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Stencil: the configured microstate structure and the given data are not compatible.");
+
+    const auto dims = strides_x.size() - 1;
+
+    vector_step_x = strides_x[0];
+    vector_step_y = strides_y[0];
+    steps_x.assign(strides_x.begin() + 1, strides_x.end());
+    steps_y.assign(strides_y.begin() + 1, strides_y.end());
+
+    //      Compile each cell of the structure into linear offsets.
+    const auto &stencil = settings.stencil();
+    cells_x.resize(settings.get_hypervolume());
+    cells_y.resize(settings.get_hypervolume());
+
+    for (size_t m = 0; m < settings.get_hypervolume(); m++) {
+        const auto *cell = stencil.data() + m * settings.dimensions();
+
+        std::ptrdiff_t offset_x = 0;
+        std::ptrdiff_t offset_y = 0;
+        for (size_t d = 0; d < dims; d++) {
+            offset_x += static_cast<std::ptrdiff_t>(cell[d]) * steps_x[d];
+            offset_y += static_cast<std::ptrdiff_t>(cell[dims + d]) * steps_y[d];
+        }
+
+        cells_x[m] = offset_x;
+        cells_y[m] = offset_y;
+    }
+
+    //      The x dimensions run first, so the first patch_x cells walk the x patch and every patch_x-th cell
+    //  walks the y patch.
+    points_x.assign(cells_x.begin(), cells_x.begin() + static_cast<std::ptrdiff_t>(settings.patch_x()));
+    for (size_t b = 0; b < settings.patch_y(); b++) points_y.push_back(cells_y[b * settings.patch_x()]);
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,76 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Stencil header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef STENCIL_H
+#define STENCIL_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <vector>
+#include <cstddef>
+
+#include "settings.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Stencil class structure.
+    //      It is the microstate structure of a Settings compiled against the strides of data x and data y: each
+    //  cell becomes a pair of linear offsets relative to the base index of a sample, so a microstate is only a
+    //  fixed sequence of loads, without any index arithmetic or allocation.
+    class Stencil {
+        std::vector<std::ptrdiff_t> cells_x;
+        std::vector<std::ptrdiff_t> cells_y;
+
+        std::vector<std::ptrdiff_t> points_x;
+        std::vector<std::ptrdiff_t> points_y;
+
+        std::vector<std::ptrdiff_t> steps_x;
+        std::vector<std::ptrdiff_t> steps_y;
+
+        std::ptrdiff_t vector_step_x;
+        std::ptrdiff_t vector_step_y;
+        size_t length;
+
+    public:
+        [[nodiscard]] size_t cells() const { return cells_x.size(); }
+        [[nodiscard]] size_t dimensions() const { return steps_x.size(); }
+        [[nodiscard]] size_t vector_size() const { return length; }
+        [[nodiscard]] std::ptrdiff_t step_x() const { return vector_step_x; }
+        [[nodiscard]] std::ptrdiff_t step_y() const { return vector_step_y; }
+        [[nodiscard]] const std::ptrdiff_t *offsets_x() const { return cells_x.data(); }
+        [[nodiscard]] const std::ptrdiff_t *offsets_y() const { return cells_y.data(); }
+
+        //      Offsets of the points of the x and y patches, the cell a + patch_x * b compares the points a and b.
+        [[nodiscard]] const std::ptrdiff_t *patch_x() const { return points_x.data(); }
+        [[nodiscard]] const std::ptrdiff_t *patch_y() const { return points_y.data(); }
+
+        //      Linear index of a sample, given as the D = 2 * dimensions() values [x indexes..., y indexes...].
+        [[nodiscard]] std::ptrdiff_t base_x(const size_t *sample) const {
+            std::ptrdiff_t index = 0;
+            for (size_t d = 0; d < steps_x.size(); d++) index += static_cast<std::ptrdiff_t>(sample[d]) * steps_x[d];
+            return index;
+        }
+
+        [[nodiscard]] std::ptrdiff_t base_y(const size_t *sample) const {
+            std::ptrdiff_t index = 0;
+            for (size_t d = 0; d < steps_y.size(); d++) index += static_cast<std::ptrdiff_t>(sample[steps_x.size() + d]) * steps_y[d];
+            return index;
+        }
+
+        //      The strides include the first (vector) dimension, exactly as a Tensor stores them.
+        Stencil(const Settings &settings, const std::vector<std::ptrdiff_t> &strides_x, const std::vector<std::ptrdiff_t> &strides_y,
+            size_t length);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
@@ -0,0 +1,183 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Stream .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "stream.h"
+//                * Include the used libraries.
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+//      -------------------------------------------------------------------------------------------------------
+//              * Microstates with a fixed row j, for i in [first, last - patch_x + 1]: each step shifts one column.
+template<typename F> void RecurrenceMicrostates::Stream::along_i(const size_t j, const size_t first, const size_t last, F &&emit) const {
+    const auto patch_x = settings.patch_x();
+    const auto patch_y = settings.patch_y();
+
+    uint64_t microstate = 0;
+    for (auto column = first; column <= last; column++) {
+        microstate = (microstate >> 1) & ~top;
+        for (size_t b = 0; b < patch_y; b++) microstate |= bit(column, j + b) << (b * patch_x + patch_x - 1);
+
+        if (column + 1 >= first + patch_x) emit(column + 1 - patch_x, microstate);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Microstates with a fixed column i, for j in [first, last - patch_y + 1]: each step shifts one row.
+template<typename F> void RecurrenceMicrostates::Stream::along_j(const size_t i, const size_t first, const size_t last, F &&emit) const {
+    const auto patch_x = settings.patch_x();
+    const auto patch_y = settings.patch_y();
+
+    uint64_t microstate = 0;
+    for (auto row = first; row <= last; row++) {
+        uint64_t group = 0;
+        for (size_t a = 0; a < patch_x; a++) group |= bit(i + a, row) << a;
+        microstate = (patch_x == STREAM_WORD ? 0 : microstate >> patch_x) | group << (patch_x * (patch_y - 1));
+
+        if (row + 1 >= first + patch_y) emit(row + 1 - patch_y, microstate);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * The microstates inside [e, last] that start at the point e (min(i, j) = e).
+template<typename F> void RecurrenceMicrostates::Stream::starting(const size_t e, const size_t last, F &&emit) const {
+    if (last + 1 >= e + settings.patch_x())
+        along_j(e, e, last, [&](size_t, const uint64_t microstate) { emit(microstate); });
+    if (last + 1 >= e + settings.patch_y())
+        along_i(e, e, last, [&](const size_t i, const uint64_t microstate) { if (i != e) emit(microstate); });
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * The microstates inside [first, t] that end at the point t (max(i + patch_x, j + patch_y) - 1 = t).
+template<typename F> void RecurrenceMicrostates::Stream::ending(const size_t t, const size_t first, F &&emit) const {
+    const auto patch_x = settings.patch_x();
+    const auto patch_y = settings.patch_y();
+
+    if (t + 1 >= first + patch_x)
+        along_j(t + 1 - patch_x, first, t, [&](size_t, const uint64_t microstate) { emit(microstate); });
+    if (t + 1 >= first + patch_y)
+        along_i(t + 1 - patch_y, first, t, [&](const size_t i, const uint64_t microstate) { if (i + patch_x != t + 1) emit(microstate); });
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Stream::append(const double *point, const std::ptrdiff_t step) {
+    const auto t = pushed;
+    const auto add = [&](const uint64_t microstate) {
+        if (settings.dictionary()) sparse.add(microstate);
+        else dense[microstate]++;
+        total++;
+    };
+    const auto remove = [&](const uint64_t microstate) {
+        if (settings.dictionary()) sparse.remove(microstate);
+        else dense[microstate]--;
+        total--;
+    };
+
+    //      The point t - window leaves: its microstates go while its row is still in the ring.
+    if (expire && t >= window) starting(t - window, t - 1, remove);
+
+    //      The point t takes its place, with the row of its recurrences with the window.
+    const auto slot = t % window;
+    for (size_t i = 0; i < length; i++) points[slot * length + i] = point[static_cast<std::ptrdiff_t>(i) * step];
+
+    auto *row = bits.data() + slot * words;
+    for (size_t w = 0; w < words; w++) {
+        const auto first = w * STREAM_WORD;
+        row[w] = (*recurrence)(points.data() + first * length, word_x.data(), 1, points.data() + slot * length, word_y.data(), 1,
+            std::min<size_t>(STREAM_WORD, window - first));
+    }
+
+    ending(t, t + 1 >= window ? t + 1 - window : 0, add);
+    pushed++;
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Stream::push(const double *data, const size_t vector, const size_t count, const std::ptrdiff_t step,
+    const std::ptrdiff_t time) {
+    std::lock_guard lock(mutex);
+
+    //      The first chunk fixes the vector size.
+    if (!recurrence) {
+        length = vector;
+        points.assign(window * length, 0.0);
+        recurrence.emplace(metric, threshold, length);
+        for (size_t m = 0; m < STREAM_WORD; m++) word_x[m] = static_cast<std::ptrdiff_t>(m * length);
+    } else if (vector != length) {
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Stream: all the chunks must have the same vector size.");
+    }
+
+    for (size_t t = 0; t < count; t++) append(data + static_cast<std::ptrdiff_t>(t) * time, step);
+}
+//      -------------------------------------------------------------------------------------------------------
+size_t RecurrenceMicrostates::Stream::size() const {
+    std::lock_guard lock(mutex);
+    return pushed;
+}
+//      -------------------------------------------------------------------------------------------------------
+size_t RecurrenceMicrostates::Stream::microstates() const {
+    std::lock_guard lock(mutex);
+    return total;
+}
+//      -------------------------------------------------------------------------------------------------------
+std::vector<double> RecurrenceMicrostates::Stream::snapshot() const {
+    std::lock_guard lock(mutex);
+    const auto scale = total > 0 ? static_cast<double>(total) : 1.0;
+
+    std::vector<double> result;
+    if (settings.dictionary()) {
+        std::vector<uint64_t> found;
+        std::vector<size_t> counts;
+        sparse.sorted(found, counts);
+        for (const auto c : counts) result.push_back(static_cast<double>(c) / scale);
+    } else {
+        result.reserve(dense.size());
+        for (const auto c : dense) result.push_back(static_cast<double>(c) / scale);
+    }
+
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+std::vector<uint64_t> RecurrenceMicrostates::Stream::keys() const {
+    if (!this->settings.dictionary()) throw std::runtime_error("[ERROR] Recurrence Microstates - Stream: keys are only available in the dictionary mode, use snapshot().");
+
+    std::lock_guard lock(mutex);
+    std::vector<uint64_t> found;
+    std::vector<size_t> counts;
+    sparse.sorted(found, counts);
+    return found;
+}
+//      -------------------------------------------------------------------------------------------------------
+std::vector<size_t> RecurrenceMicrostates::Stream::counts() const {
+    std::lock_guard lock(mutex);
+
+    //      In the vector mode the counts are dense, indexed by the microstate.
+    if (!this->settings.dictionary()) return dense;
+
+    std::vector<uint64_t> found;
+    std::vector<size_t> counts;
+    sparse.sorted(found, counts);
+    return counts;
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Stream::Stream(const Settings &settings, const double threshold, const size_t window, const unsigned short metric,
+    const bool expire) : settings(settings), metric(metric), threshold(threshold), window(window), expire(expire),
+    words((window + STREAM_WORD - 1) / STREAM_WORD), word_x(STREAM_WORD), word_y(STREAM_WORD, 0) {
+
+    //      Check the input before to do anything.
+    if (this->settings.dimensions() != 2)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Stream: the stream requires a two dimensional structure.");
+    if (window < std::max(this->settings.patch_x(), this->settings.patch_y()))
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Stream: the window must hold the microstate structure.");
+
+    bits.assign(window * words, 0);
+    for (size_t b = 0; b < this->settings.patch_y(); b++) top |= uint64_t{1} << (b * this->settings.patch_x() + this->settings.patch_x() - 1);
+    if (!this->settings.dictionary()) dense.assign(this->settings.possibilities(), 0);
+}
+//      -------------------------------------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Stream header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef STREAM_H
+#define STREAM_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "settings.h"
+#include "recurrence.h"
+#include "histogram.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define STREAM_WORD 64
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Stream class structure.
+    //      It keeps the microstate histogram of the recurrence plot of a time series that arrives in chunks. Only
+    //  the last window points are kept, in a ring, with the recurrences between them bit-packed: the row of the
+    //  point p holds its recurrences with the window before it. A new point t costs one row of recurrences (window
+    //  distances) and the microstates that end at t, read by sliding a register along the row and the column of t,
+    //  O(window * k) in total. With expire, the microstates that start at the point that leaves the window are
+    //  taken back in the same way, so the histogram is always the one of the window. A mutex keeps the pushes and
+    //  the reads of different threads apart.
+    class Stream {
+        Settings settings;
+        const unsigned short metric;
+        const double threshold;
+        const size_t window;
+        const bool expire;
+
+        std::optional<Recurrence> recurrence;
+        size_t length = 0;
+        size_t words;
+        size_t pushed = 0;
+        size_t total = 0;
+        uint64_t top = 0;
+
+        std::vector<double> points;
+        std::vector<uint64_t> bits;
+        std::vector<std::ptrdiff_t> word_x;
+        std::vector<std::ptrdiff_t> word_y;
+
+        std::vector<size_t> dense;
+        FlatHistogram sparse;
+
+        mutable std::mutex mutex;
+
+        //      The recurrence of the points p and q, both inside the window.
+        [[nodiscard]] uint64_t bit(const size_t p, const size_t q) const {
+            const auto row = p >= q ? p : q;
+            const auto column = (p >= q ? q : p) % window;
+            return bits[(row % window) * words + column / STREAM_WORD] >> (column % STREAM_WORD) & 1;
+        }
+
+        template<typename F> void along_i(size_t j, size_t first, size_t last, F &&emit) const;
+        template<typename F> void along_j(size_t i, size_t first, size_t last, F &&emit) const;
+        template<typename F> void starting(size_t e, size_t last, F &&emit) const;
+        template<typename F> void ending(size_t t, size_t first, F &&emit) const;
+
+        void append(const double *point, std::ptrdiff_t step);
+
+    public:
+        [[nodiscard]] bool dictionary() const { return settings.dictionary(); }
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t microstates() const;
+
+        //      Add count points of vector values: the value i of the point t is data[t * time + i * step]. The first
+        //  push fixes the vector size.
+        void push(const double *data, size_t vector, size_t count, std::ptrdiff_t step, std::ptrdiff_t time);
+
+        //      The probabilities of the current histogram. In the dictionary mode they follow the microstates of keys().
+        [[nodiscard]] std::vector<double> snapshot() const;
+        [[nodiscard]] std::vector<uint64_t> keys() const;
+        [[nodiscard]] std::vector<size_t> counts() const;
+
+        explicit Stream(const Settings &settings, double threshold, size_t window, unsigned short metric = METRIC_EUCLIDEAN,
+            bool expire = true);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
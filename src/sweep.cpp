@@ -0,0 +1,178 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Sweep .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "sweep.h"
+//                * Include the used libraries.
+#include <bit>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "histogram.h"
+#include "threadpool.h"
+#include "counting.h"
+#include "arrays.h"
+#include "probabilities.h"
+//      -------------------------------------------------------------------------------------------------------
+template<typename Counter>
+size_t RecurrenceMicrostates::Sweep::task_compute(const size_t begin, const size_t end, Counter &&count) const {
+    const auto rows = limits.size();
+    const auto cells = stencil.cells();
+    const Distance distance(metric, stencil.vector_size());
+
+    std::vector<size_t> sample(sampler.dimensions());
+    auto cursor = sampler.cursor();
+    std::vector<double> distances(cells);
+    std::vector<uint64_t> first(rows + 1);
+
+    for (auto s = begin; s < end; s++) {
+        sampler(s, sample.data(), cursor);
+        const auto *base_x = data_x.pointer() + stencil.base_x(sample.data());
+        const auto *base_y = data_y.pointer() + stencil.base_y(sample.data());
+
+        distance(base_x, stencil.offsets_x(), stencil.step_x(), base_y, stencil.offsets_y(), stencil.step_y(), cells,
+            distances.data());
+
+        //      first[k] has the cells that become recurrent at the sorted threshold k (a NaN never recurs).
+        std::ranges::fill(first, 0);
+        for (size_t m = 0; m < cells; m++) {
+            const auto k = std::isnan(distances[m]) ? rows : static_cast<size_t>(std::ranges::lower_bound(limits, distances[m]) - limits.begin());
+            first[k] |= uint64_t{1} << m;
+        }
+
+        uint64_t microstate = 0;
+        for (size_t k = 0; k < rows; k++) {
+            microstate |= first[k];
+            count(order[k], microstate);
+        }
+    }
+
+    return end - begin;
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Sweep::compute_to_vector() {
+    const auto possibilities = settings.possibilities();
+
+    //      A single dense histogram of (thresholds, 2^hypervolume) entries: the threshold is the row of the bin.
+    std::vector<size_t> counts;
+    const auto counter = count_bins(settings, given.size() * possibilities, sampler.size(), DEFAULT_CHUNK,
+        [&](const size_t begin, const size_t end, auto &&count) {
+            return task_compute(begin, end, [&](const size_t row, const uint64_t microstate) { count(row * possibilities + microstate); });
+        }, counts);
+
+    normalize_counts(settings, counts, counter, this->vect_result);
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::Sweep::compute_to_dict() {
+    const auto rows = given.size();
+    const auto hypervolume = settings.get_hypervolume();
+
+    //      The row goes to the bits above the microstate, so a single hash histogram counts all the thresholds and
+    //  its sorted keys are in the order (row, microstate). When they do not fit in 64 bits, the rows are counted
+    //  in groups that do, each one a pass over the samples.
+    const auto mask = hypervolume < 64 ? (uint64_t{1} << hypervolume) - 1 : ~uint64_t{0};
+    const auto group = hypervolume < 64 ? std::min<uint64_t>(rows, uint64_t{1} << (64 - hypervolume)) : uint64_t{1};
+
+    this->dict_rows.clear();
+    this->dict_keys.clear();
+    this->dict_counts.clear();
+
+    size_t counter = 0;
+    std::vector<uint64_t> keys;
+    std::vector<size_t> counts;
+    for (size_t first = 0; first < rows; first += group) {
+        const auto last = std::min<size_t>(rows, first + group);
+
+        FlatHistogram histogram;
+        counter = count_sparse(settings, sampler.size(), DEFAULT_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+            return task_compute(begin, end, [&](const size_t row, const uint64_t microstate) {
+                if (row >= first && row < last) count(hypervolume < 64 ? (static_cast<uint64_t>(row - first) << hypervolume) | microstate : microstate);
+            });
+        }, histogram);
+
+        histogram.sorted(keys, counts);
+        for (const auto key : keys) {
+            this->dict_rows.push_back(first + (hypervolume < 64 ? static_cast<size_t>(key >> hypervolume) : 0));
+            this->dict_keys.push_back(key & mask);
+        }
+        this->dict_counts.insert(this->dict_counts.end(), counts.begin(), counts.end());
+    }
+
+    normalize_counts(settings, this->dict_counts, counter, this->vect_result);
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<double> RecurrenceMicrostates::Sweep::probabilities() const {
+    if (this->use_dictionary) return view_array(this, vect_result);
+    return view_array(this, vect_result, {static_cast<pybind11::ssize_t>(given.size()), static_cast<pybind11::ssize_t>(settings.possibilities())});
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<double> RecurrenceMicrostates::Sweep::thresholds() const {
+    return view_array(this, given);
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<size_t> RecurrenceMicrostates::Sweep::rows() const {
+    if (!this->use_dictionary) throw std::runtime_error("[ERROR] Recurrence Microstates - Sweep: rows are only available in the dictionary mode, use probabilities().");
+    return view_array(this, dict_rows);
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<uint64_t> RecurrenceMicrostates::Sweep::keys() const {
+    if (!this->use_dictionary) throw std::runtime_error("[ERROR] Recurrence Microstates - Sweep: keys are only available in the dictionary mode, use probabilities().");
+    return view_array(this, dict_keys);
+}
+//      -------------------------------------------------------------------------------------------------------
+pybind11::array_t<size_t> RecurrenceMicrostates::Sweep::counts() const {
+    if (!this->use_dictionary) throw std::runtime_error("[ERROR] Recurrence Microstates - Sweep: counts are only available in the dictionary mode, use probabilities().");
+    return view_array(this, dict_counts);
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Sweep::Sweep(const pybind11::capsule &settings, const pybind11::array_t<double> &data_x,
+    const pybind11::array_t<double> &data_y, const pybind11::array_t<double> &thresholds, const double sample_rate,
+    const std::string &metric, const std::optional<uint64_t> seed) : metric(metric_from_name(metric)), data_x(data_x),
+    data_y(data_y), settings(*static_cast<Settings*>(settings.get_pointer())),
+    stencil(this->settings, this->data_x.stride_table(), this->data_y.stride_table(), this->data_x.dimension(0)),
+    sampler(this->settings, this->data_x.dimensions(), this->data_y.dimensions(), sample_rate, seed.value_or(random_seed())) {
+
+    //      Check the input arguments.
+    check_data(this->settings, this->data_x.dimensions(), this->data_y.dimensions());
+
+    this->given = numpy_to_vector(thresholds);
+    if (this->given.empty()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Sweep: at least one threshold is required.");
+    if (std::ranges::any_of(this->given, [](const double t) { return std::isnan(t); }))
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Sweep: the thresholds cannot be NaN.");
+
+    //      Sort the thresholds (in the scale of the distances), keeping where each one came from.
+    this->order.resize(this->given.size());
+    std::iota(this->order.begin(), this->order.end(), size_t{0});
+    std::ranges::stable_sort(this->order, {}, [&](const size_t i) { return this->given[i]; });
+
+    for (const auto i : this->order) this->limits.push_back(scale_threshold(this->metric, this->given[i]));
+
+    //      The dense histogram has an entry per threshold and microstate in each thread, so the thresholds count
+    //  for the vector/dictionary decision as the extra bits of the row.
+    const auto bits = this->settings.get_hypervolume() + std::bit_width(this->given.size() - 1);
+    this->use_dictionary = this->settings.dictionary(bits);
+    if (!this->use_dictionary && bits > SWEEP_MAX_VECTOR_BITS)
+        throw std::invalid_argument("[ERROR] Recurrence Microstates - Sweep: the (thresholds, 2^hypervolume) histogram is too large for the vector mode, use the dictionary mode or fewer thresholds.");
+
+    pybind11::gil_scoped_release release;
+    if (this->use_dictionary) this->compute_to_dict();
+    else this->compute_to_vector();
+}
+//      -------------------------------------------------------------------------------------------------------
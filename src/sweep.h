@@ -0,0 +1,86 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Sweep header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef SWEEP_H
+#define SWEEP_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <string>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "tensor.h"
+#include "settings.h"
+#include "stencil.h"
+#include "sampler.h"
+#include "recurrence.h"
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define SWEEP_MAX_VECTOR_BITS 32        //  Largest (thresholds, 2^hypervolume) histogram of the vector mode, 32 GiB per thread.
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our Sweep class structure.
+    //      It computes the microstate probabilities for many thresholds in a single pass: the distance of each cell
+    //  is computed once per sample and sorted into all the thresholds with a binary search. The cell m is recurrent
+    //  for every threshold from the first one that is not smaller than its distance, so each microstate is the
+    //  previous one plus the cells that start there.
+    class Sweep {
+        const unsigned short metric;
+        const Tensor<double> data_x;
+        const Tensor<double> data_y;
+
+        Settings settings;
+        Stencil stencil;
+        Sampler sampler;
+        bool use_dictionary = false;
+
+        std::vector<double> given;
+        std::vector<double> limits;
+        std::vector<size_t> order;
+
+        std::vector<double> vect_result;
+        std::vector<size_t> dict_rows;
+        std::vector<uint64_t> dict_keys;
+        std::vector<size_t> dict_counts;
+
+        void compute_to_vector();
+        void compute_to_dict();
+
+        template<typename Counter> size_t task_compute(size_t begin, size_t end, Counter &&count) const;
+
+    public:
+        [[nodiscard]] bool dictionary() const { return use_dictionary; }
+        [[nodiscard]] uint64_t seed() const { return sampler.seed(); }
+
+        //      The dictionary mode is used when the Settings ask for it, or when the (thresholds, 2^hypervolume)
+        //  histogram passes the dictionary threshold of the Settings.
+        //      In the vector mode the probabilities are a (thresholds, 2^hypervolume) matrix. In the dictionary mode
+        //  they are sparse: entry i is the microstate keys()[i] of the threshold thresholds()[rows()[i]].
+        [[nodiscard]] pybind11::array_t<double> probabilities() const;
+        [[nodiscard]] pybind11::array_t<double> thresholds() const;
+        [[nodiscard]] pybind11::array_t<size_t> rows() const;
+        [[nodiscard]] pybind11::array_t<uint64_t> keys() const;
+        [[nodiscard]] pybind11::array_t<size_t> counts() const;
+
+        explicit Sweep(const pybind11::capsule &settings, const pybind11::array_t<double> &data_x,
+            const pybind11::array_t<double> &data_y, const pybind11::array_t<double> &thresholds, double sample_rate = 0.2,
+            const std::string &metric = DEFAULT_METRIC, std::optional<uint64_t> seed = std::nullopt);
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
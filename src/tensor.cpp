@@ -15,18 +15,20 @@
 #include "tensor.h"
 //                * Include the used libraries.
 #include <vector>
+#include <variant>
+#include <cstdint>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 //      -------------------------------------------------------------------------------------------------------
 template<typename T>
-size_t RecurrenceMicrostates::Tensor<T>::get_index(const std::vector<size_t> &shape) const {
+std::ptrdiff_t RecurrenceMicrostates::Tensor<T>::get_index(const std::vector<size_t> &indexes) const {
     //      Check if the number of dimensions is equals.
-    if (shape.size() != this->shape.size()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Tensor: shapes must have the same size.");
+    if (indexes.size() != this->shape.size()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Tensor: shapes must have the same size.");
 
-    //      Compute the index.
-    auto index = shape[0];
-    for (size_t i = 1; i < shape.size(); i++)
-        index += shape[i] * std::accumulate(this->shape.begin(), static_cast<std::ptrdiff_t>(i + this->shape.begin()), size_t{1}, std::multiplies());
+    //      Compute the index using the precomputed strides.
+    std::ptrdiff_t index = 0;
+    for (size_t i = 0; i < indexes.size(); i++)
+        index += static_cast<std::ptrdiff_t>(indexes[i]) * strides[i];
 
     return index;
 }
@@ -36,24 +38,123 @@ std::vector<T> RecurrenceMicrostates::Tensor<T>::vector(const std::vector<size_t
     //      Check the input.
     if (indexes.size() != this->shape.size() - 1) throw std::invalid_argument("[ERROR] Recurrence Microstates - Tensor: the vector index must have the size of the tensor shape minus one.");
 
-    //      Make the shape array to get the index.
-    std::vector<size_t> shape;
-    shape.resize(this->shape.size());
-
-    shape[0] = indexes[0];
-    std::ranges::copy(indexes, shape.begin() + 1);
+    //      Find the first element of the column.
+    const T *ptr = data;
+    for (size_t i = 0; i < indexes.size(); i++)
+        ptr += static_cast<std::ptrdiff_t>(indexes[i]) * strides[i + 1];
 
     //      Make the result vector.
-    std::vector<T> result;
-    for (size_t i = 0; i < this->shape[0]; i++) {
-        result.push_back(body[get_index(shape)]);
-        ++shape[0];
-    }
+    std::vector<T> result(this->shape[0]);
+    for (size_t i = 0; i < this->shape[0]; i++, ptr += strides[0])
+        result[i] = *ptr;
 
     return result;
 }
 //      -------------------------------------------------------------------------------------------------------
 template<typename T>
-RecurrenceMicrostates::Tensor<T>::Tensor(const pybind11::array_t<T> &array) {
+RecurrenceMicrostates::Tensor<T>::Tensor(const std::vector<size_t> &shape) : shape(shape) {
+    //      Column-major strides, the same memory layout used by the original implementation.
+    strides.resize(shape.size());
+    std::ptrdiff_t step = 1;
+    for (size_t i = 0; i < shape.size(); i++) {
+        strides[i] = step;
+        step *= static_cast<std::ptrdiff_t>(shape[i]);
+    }
+
+    body.resize(std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies()));
+    data = body.data();
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::Tensor<T>::Tensor(const pybind11::array_t<T> &array) : view(true), base(array) {
+    const pybind11::buffer_info info = array.request();
+
+    if (info.ndim < 1) throw std::invalid_argument("[ERROR] Recurrence Microstates - Tensor: the given array must have at least one dimension.");
+
+    //      NumPy gives us the strides in bytes, we want them in elements.
+    shape.resize(info.ndim);
+    strides.resize(info.ndim);
+    for (pybind11::ssize_t i = 0; i < info.ndim; i++) {
+        if (info.strides[i] % static_cast<pybind11::ssize_t>(sizeof(T)) != 0)
+            throw std::invalid_argument("[ERROR] Recurrence Microstates - Tensor: the given array is not aligned with its data type.");
+
+        shape[i] = static_cast<size_t>(info.shape[i]);
+        strides[i] = info.strides[i] / static_cast<pybind11::ssize_t>(sizeof(T));
+    }
+
+    data = static_cast<T*>(info.ptr);
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::Tensor<T>::Tensor(const Tensor &other) : shape(other.shape), strides(other.strides),
+    body(other.body), data(other.view ? other.data : body.data()), view(other.view), base(other.base) {
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::Tensor<T>::Tensor(Tensor &&other) noexcept : shape(std::move(other.shape)),
+    strides(std::move(other.strides)), body(std::move(other.body)), data(other.view ? other.data : body.data()),
+    view(other.view), base(std::move(other.base)) {
+    other.data = nullptr;
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::Tensor<T> &RecurrenceMicrostates::Tensor<T>::operator=(const Tensor &other) {
+    if (this == &other) return *this;
+
+    shape = other.shape;
+    strides = other.strides;
+    body = other.body;
+    view = other.view;
+    base = other.base;
+    data = view ? other.data : body.data();
+    return *this;
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T>
+RecurrenceMicrostates::Tensor<T> &RecurrenceMicrostates::Tensor<T>::operator=(Tensor &&other) noexcept {
+    if (this == &other) return *this;
+
+    shape = std::move(other.shape);
+    strides = std::move(other.strides);
+    body = std::move(other.body);
+    view = other.view;
+    base = std::move(other.base);
+    data = view ? other.data : body.data();
+    other.data = nullptr;
+    return *this;
+}
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    template<typename T> bool both(const pybind11::object &array, const pybind11::object &other) {
+        return pybind11::isinstance<pybind11::array_t<T>>(array) && pybind11::isinstance<pybind11::array_t<T>>(other);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::Data RecurrenceMicrostates::make_data(const pybind11::object &array, const pybind11::object &other) {
+    if (both<float>(array, other)) return Tensor<float>(array.cast<pybind11::array_t<float>>());
+    if (both<int32_t>(array, other)) return Tensor<int32_t>(array.cast<pybind11::array_t<int32_t>>());
+    if (both<int16_t>(array, other)) return Tensor<int16_t>(array.cast<pybind11::array_t<int16_t>>());
+    if (both<uint8_t>(array, other)) return Tensor<uint8_t>(array.cast<pybind11::array_t<uint8_t>>());
+
+    return Tensor<double>(array.cast<pybind11::array_t<double>>());
+}
+//      -------------------------------------------------------------------------------------------------------
+const std::vector<size_t> &RecurrenceMicrostates::dimensions(const Data &data) {
+    return std::visit([](const auto &tensor) -> const std::vector<size_t> & { return tensor.dimensions(); }, data);
+}
+//      -------------------------------------------------------------------------------------------------------
+const std::vector<std::ptrdiff_t> &RecurrenceMicrostates::strides(const Data &data) {
+    return std::visit([](const auto &tensor) -> const std::vector<std::ptrdiff_t> & { return tensor.stride_table(); }, data);
+}
+//      -------------------------------------------------------------------------------------------------------
+size_t RecurrenceMicrostates::element_size(const Data &data) {
+    return std::visit([](const auto &tensor) { return sizeof(*tensor.pointer()); }, data);
 }
-//      -------------------------------------------------------------------------------------------------------
\ No newline at end of file
+//      -------------------------------------------------------------------------------------------------------
+//              * Explicit instantiations used by the library.
+template class RecurrenceMicrostates::Tensor<double>;
+template class RecurrenceMicrostates::Tensor<float>;
+template class RecurrenceMicrostates::Tensor<int32_t>;
+template class RecurrenceMicrostates::Tensor<int16_t>;
+template class RecurrenceMicrostates::Tensor<uint8_t>;
+//      -------------------------------------------------------------------------------------------------------
@@ -16,42 +16,83 @@
 //      -------------------------------------------------------------------------------------------------------
 //              * Include the libraries that we will use.
 #include <vector>
+#include <variant>
 #include <numeric>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
 #include <pybind11/numpy.h>
 //      -------------------------------------------------------------------------------------------------------
 //              * Namespace RecurrenceMicrostates
 namespace RecurrenceMicrostates {
     //      -------------------------------------------------------------------------------------------------------
     //              * Our tensor class.
+    //      A tensor can own its memory (body) or be a view that borrows a NumPy buffer without copying it. In
+    //  both cases the element strides are precomputed, so an index is just a dot product with the stride table.
     template <typename T> class Tensor {
         std::vector<size_t> shape;
+        std::vector<std::ptrdiff_t> strides;
         std::vector<T> body;
 
-        [[nodiscard]] size_t get_index(const std::vector<size_t> &shape) const;
+        T *data = nullptr;
+        bool view = false;
+        pybind11::object base;
+
+        [[nodiscard]] std::ptrdiff_t get_index(const std::vector<size_t> &indexes) const;
+
+        template <typename... Args> [[nodiscard]] std::ptrdiff_t get_index(Args... args) const {
+            if (sizeof...(Args) != shape.size()) throw std::invalid_argument("[ERROR] Recurrence Microstates - Tensor: shapes must have the same size.");
+
+            size_t d = 0;
+            std::ptrdiff_t index = 0;
+            ((index += static_cast<std::ptrdiff_t>(args) * strides[d++]), ...);
+            return index;
+        }
 
     public:
         //      Class proprieties.
-        [[nodiscard]] std::vector<size_t> dimensions() const { return shape; }
+        [[nodiscard]] const std::vector<size_t> &dimensions() const { return shape; }
         [[nodiscard]] size_t dimension(size_t d) const { return shape[d]; }
+        [[nodiscard]] std::ptrdiff_t stride(size_t d) const { return strides[d]; }
+        [[nodiscard]] const std::vector<std::ptrdiff_t> &stride_table() const { return strides; }
+        [[nodiscard]] const T *pointer() const { return data; }
+        [[nodiscard]] bool is_view() const { return view; }
 
         //      Get a vector projection of our tensor as a "column" for the first dimension.
         std::vector<T> vector(const std::vector<size_t> &indexes) const;
 
-        //      Constructor
-        explicit Tensor(const std::vector<size_t> &shape) : shape(shape) {
-            body.resize(std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies()));
-        }
+        //      Constructors
+        //          - Owning tensor, stored in column-major (Fortran) order.
+        explicit Tensor(const std::vector<size_t> &shape);
+        //          - Non-owning view over a NumPy array, keeping its strides (C, Fortran or sliced).
         explicit Tensor(const pybind11::array_t<T> &array);
 
+        Tensor(const Tensor &other);
+        Tensor(Tensor &&other) noexcept;
+        Tensor &operator=(const Tensor &other);
+        Tensor &operator=(Tensor &&other) noexcept;
+
         //      Operator [] to access / modify elements.
         template <typename... Args> T& operator[] (Args... args) {
-            return body[get_index({static_cast<size_t>(args)...})];
+            return data[get_index(args...)];
         }
 
         template <typename... Args> const T& operator[] (Args... args) const {
-            return body[get_index({static_cast<size_t>(args)...})];
+            return data[get_index(args...)];
         }
     };
     //      -------------------------------------------------------------------------------------------------------
+    //              * The input data in one of the types that the kernels read without a conversion.
+    using Data = std::variant<Tensor<double>, Tensor<float>, Tensor<int32_t>, Tensor<int16_t>, Tensor<uint8_t>>;
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A view over the array in its own type when it and the other array share a supported dtype,
+    //  otherwise the array is converted to float64 (as any list or other dtype).
+    Data make_data(const pybind11::object &array, const pybind11::object &other);
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Proprieties shared by all the data types.
+    const std::vector<size_t> &dimensions(const Data &data);
+    const std::vector<std::ptrdiff_t> &strides(const Data &data);
+    size_t element_size(const Data &data);
+    //      -------------------------------------------------------------------------------------------------------
 }
-#endif
\ No newline at end of file
+#endif
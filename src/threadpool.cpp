@@ -0,0 +1,134 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Thread pool .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the file header.
+#include "threadpool.h"
+//                * Include the used libraries.
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <exception>
+#include <functional>
+//      -------------------------------------------------------------------------------------------------------
+namespace {
+    //      True in the threads that are running a job of the pool.
+    thread_local bool inside_pool = false;
+}
+//      -------------------------------------------------------------------------------------------------------
+std::shared_ptr<RecurrenceMicrostates::ThreadPool> RecurrenceMicrostates::ThreadPool::instance(const unsigned int workers) {
+    static std::mutex guard;
+    static std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>();
+
+    std::lock_guard lock(guard);
+    pool->grow(workers);
+    return pool;
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::ThreadPool::grow(const unsigned int workers) {
+    //      The caller is the worker 0, so we need workers - 1 threads. Most calls do not need a new one and return
+    //  before any lock. Growing does not wait for a running job: a new thread only joins the next one, because its id
+    //  is not below the participants of the current job.
+    if (size() >= workers) return;
+
+    std::lock_guard lock(growth);
+    while (threads.size() + 1 < workers) {
+        const auto id = static_cast<unsigned int>(threads.size()) + 1;
+        threads.emplace_back(&ThreadPool::loop, this, id);
+        available.store(id, std::memory_order_release);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::ThreadPool::loop(const unsigned int id) {
+    inside_pool = true;
+    size_t seen = 0;
+
+    while (true) {
+        const std::function<void(unsigned int)> *task;
+        unsigned int workers, step;
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [&] { return stop || (generation != seen && id < participants); });
+            if (stop) return;
+
+            seen = generation;
+            task = job;
+            workers = count;
+            step = participants;
+        }
+
+        std::exception_ptr failure;
+        try {
+            for (auto w = id; w < workers; w += step) (*task)(w);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+
+        std::lock_guard lock(mutex);
+        if (failure && !error) error = failure;
+        if (--remaining == 0) done.notify_one();
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+void RecurrenceMicrostates::ThreadPool::run(unsigned int workers, const std::function<void(unsigned int)> &job) {
+    workers = workers < 1 ? 1 : workers;
+
+    //      A nested call runs on the calling thread.
+    if (inside_pool || workers == 1) {
+        for (unsigned int w = 0; w < workers; w++) job(w);
+        return;
+    }
+
+    std::lock_guard submission(submit);
+
+    //      When there are more workers than threads, each thread runs the workers id, id + size(), ...
+    {
+        std::lock_guard lock(mutex);
+        this->job = &job;
+        this->count = workers;
+        this->participants = std::min(workers, size());
+        this->remaining = participants - 1;
+        this->error = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    std::exception_ptr failure;
+    inside_pool = true;
+    try {
+        for (unsigned int w = 0; w < workers; w += participants) job(w);
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    inside_pool = false;
+
+    std::unique_lock lock(mutex);
+    done.wait(lock, [&] { return remaining == 0; });
+    this->job = nullptr;
+    this->participants = 0;
+
+    if (!failure) failure = error;
+    if (failure) std::rethrow_exception(failure);
+}
+//      -------------------------------------------------------------------------------------------------------
+RecurrenceMicrostates::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+
+    std::lock_guard lock(growth);
+    for (auto &thread : threads) thread.join();
+}
+//      -------------------------------------------------------------------------------------------------------
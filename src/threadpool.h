@@ -0,0 +1,110 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Thread pool header
+//      -------------------------------------------------------------------------------------------------------
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define CACHE_LINE 64
+#define DEFAULT_CHUNK 256
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates
+namespace RecurrenceMicrostates {
+    //      -------------------------------------------------------------------------------------------------------
+    //              * A value alone in its cache line, to keep the per-thread results from false sharing.
+    template<typename T> struct alignas(CACHE_LINE) Padded {
+        T value{};
+        size_t counter = 0;
+    };
+    //      -------------------------------------------------------------------------------------------------------
+    //              * Our ThreadPool class structure.
+    //      There is only one pool per process, shared by every Settings: the threads are created once and then
+    //  sleep between the calls. The thread that submits a job always works on it as the worker 0.
+    class ThreadPool {
+        std::vector<std::thread> threads;
+        std::atomic<unsigned int> available = 0;
+
+        std::mutex growth;
+        std::mutex submit;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+
+        const std::function<void(unsigned int)> *job = nullptr;
+        unsigned int count = 0;
+        unsigned int participants = 0;
+        unsigned int remaining = 0;
+        size_t generation = 0;
+        bool stop = false;
+        std::exception_ptr error;
+
+        void loop(unsigned int id);
+        void grow(unsigned int workers);
+
+    public:
+        //      Get the process-wide pool, with room for at least the given number of workers.
+        static std::shared_ptr<ThreadPool> instance(unsigned int workers);
+
+        [[nodiscard]] unsigned int size() const { return available.load(std::memory_order_acquire) + 1; }
+
+        //      Run job(worker) for worker = 0, ..., workers - 1 and wait for all of them. Inside a job, the nested
+        //  calls run serially on the calling thread.
+        void run(unsigned int workers, const std::function<void(unsigned int)> &job);
+
+        //      Split [0, count) between the workers and call body(worker, begin, end) for chunks of it. A worker
+        //  that finishes its part steals the chunks left in the others, so a slow core does not stall the call.
+        template<typename F> void parallel_for(size_t count, unsigned int workers, size_t chunk, F &&body) {
+            struct alignas(CACHE_LINE) Range {
+                std::atomic<size_t> next;
+                size_t end;
+            };
+
+            workers = workers < 1 ? 1 : workers;
+            chunk = chunk < 1 ? 1 : chunk;
+
+            std::vector<Range> ranges(workers);
+            for (unsigned int w = 0; w < workers; w++) {
+                ranges[w].next = count * w / workers;
+                ranges[w].end = count * (w + 1) / workers;
+            }
+
+            run(workers, [&](const unsigned int worker) {
+                for (unsigned int k = 0; k < workers; k++) {
+                    auto &range = ranges[(worker + k) % workers];
+                    for (auto begin = range.next.fetch_add(chunk, std::memory_order_relaxed); begin < range.end;
+                         begin = range.next.fetch_add(chunk, std::memory_order_relaxed))
+                        body(worker, begin, std::min(begin + chunk, range.end));
+                }
+            });
+        }
+
+        ThreadPool() = default;
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+        ~ThreadPool();
+    };
+    //      -------------------------------------------------------------------------------------------------------
+}
+#endif
@@ -0,0 +1,44 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Test checks header
+//      -------------------------------------------------------------------------------------------------------
+//          Each test is a program that returns 0 when all its checks pass. A failed check prints where it is and
+//  the test goes on, so one run shows all the failures.
+//      -------------------------------------------------------------------------------------------------------
+#ifndef CHECK_H
+#define CHECK_H
+//      -------------------------------------------------------------------------------------------------------
+//              * Include the libraries that we will use.
+#include <cstdio>
+//      -------------------------------------------------------------------------------------------------------
+//              * Defines
+#define CHECK(condition) RecurrenceMicrostates::Testing::check(condition, #condition, __FILE__, __LINE__)
+//      -------------------------------------------------------------------------------------------------------
+//              * Namespace RecurrenceMicrostates::Testing
+namespace RecurrenceMicrostates::Testing {
+    inline int failures = 0;
+
+    inline bool check(const bool condition, const char *text, const char *file, const int line) {
+        if (!condition) {
+            std::printf("[FAILED] %s:%d: %s\n", file, line, text);
+            failures++;
+        }
+        return condition;
+    }
+
+    //      The exit code of the test.
+    inline int result() {
+        if (failures > 0) std::printf("%d check(s) failed.\n", failures);
+        return failures > 0 ? 1 : 0;
+    }
+}
+#endif
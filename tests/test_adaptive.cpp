@@ -0,0 +1,114 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Adaptive sampling tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          An adaptive run stops after a prefix of its rounds. In the tiled order a prefix of the samples is only
+//  the first tiles, so on a series whose two halves differ it would see only part of the recurrence plot. The
+//  rounds take the samples spread over all the tiles, and must give the distribution of the untiled run.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "counting.h"
+#include "convergence.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+
+#define SERIES 100000
+#define TILE 2048
+#define RATE 2e-4
+#define THRESHOLD 0.3
+//      -------------------------------------------------------------------------------------------------------
+//              * Largest difference between two probability vectors.
+double distance(const std::vector<double> &a, const std::vector<double> &b) {
+    double result = 0.0;
+    for (size_t i = 0; i < a.size(); i++) result = std::max(result, std::abs(a[i] - b[i]));
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * The counting task of the samples of a sampler over the series.
+struct Task {
+    const Sampler &sampler;
+    const Stencil stencil;
+    const Recurrence recurrence;
+    const std::vector<double> &series;
+
+    template<typename Counter> size_t operator()(const size_t begin, const size_t end, Counter &&count) const {
+        return count_microstates(sampler, begin, end, stencil, series.data(), series.data(), recurrence, count);
+    }
+
+    Task(const Settings &settings, const Sampler &sampler, const std::vector<double> &series) : sampler(sampler),
+        stencil(settings, {1, 1}, {1, 1}, 1), recurrence(METRIC_EUCLIDEAN, THRESHOLD, 1, settings.specialization()), series(series) {}
+};
+//      -------------------------------------------------------------------------------------------------------
+//              * Probabilities of an adaptive run, with the samples in the tiled order or spread over the tiles.
+std::vector<double> adaptive(const Settings &settings, const Sampler &sampler, const std::vector<double> &series, const bool spread,
+    const double tolerance, size_t &used, bool &stopped) {
+
+    const Task task(settings, sampler, series);
+    Convergence convergence(CRITERION_ENTROPY, tolerance);
+    std::vector<uint64_t> keys;
+    std::vector<size_t> counts;
+    if (spread) used = count_adaptive(settings, sampler.size(), DEFAULT_CHUNK, spread_task(sampler.size(), DEFAULT_CHUNK, task),
+        convergence, 16384, keys, counts, stopped);
+    else used = count_adaptive(settings, sampler.size(), DEFAULT_CHUNK, task, convergence, 16384, keys, counts, stopped);
+
+    //      The sparse counts follow the keys, they are spread on the dense vector to compare.
+    std::vector<double> result(settings.possibilities(), 0.0);
+    for (size_t i = 0; i < counts.size(); i++) result[settings.dictionary() ? keys[i] : i] = static_cast<double>(counts[i]) / static_cast<double>(used);
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    //      Two halves with a different spread: their recurrences are very different.
+    std::mt19937_64 generator(7);
+    std::uniform_real_distribution<double> uniform;
+    std::vector<double> series(SERIES);
+    for (size_t t = 0; t < SERIES; t++) series[t] = uniform(generator) * (t < SERIES / 2 ? 1.0 : 0.2);
+
+    for (const auto mode : {MODE_FORCE_VECTOR, MODE_FORCE_DICTIONARY}) {
+        const Settings settings({2, 2}, std::thread::hardware_concurrency(), mode);
+        const Sampler plain(settings, {1, SERIES}, {1, SERIES}, RATE, 11);
+        const Sampler tiled(settings, {1, SERIES}, {1, SERIES}, RATE, 11, {TILE}, {TILE});
+        CHECK(tiled.tiled() && !plain.tiled());
+
+        size_t used;
+        bool stopped;
+
+        //      The reference: every sample of the untiled run.
+        const auto reference = adaptive(settings, plain, series, false, 1e-300, used, stopped);
+        CHECK(used == plain.size() && !stopped);
+
+        //      The rounds spread over the tiles stop early with the distribution of the reference.
+        const auto spread = adaptive(settings, tiled, series, true, 2e-3, used, stopped);
+        CHECK(stopped && used < tiled.size() / 2);
+        CHECK(distance(spread, reference) < 0.01);
+
+        //      As many samples from the start of the tiled order do not: this is what the test guards against.
+        std::vector<double> prefix;
+        histogram_dense(settings, used, DEFAULT_CHUNK, Task(settings, tiled, series), prefix);
+        CHECK(distance(prefix, reference) > 0.05);
+
+        //      Run to the end, the spread rounds are exactly the samples of the fixed tiled run.
+        const auto whole = adaptive(settings, tiled, series, true, 1e-300, used, stopped);
+        const auto fixed = adaptive(settings, tiled, series, false, 1e-300, used, stopped);
+        CHECK(whole == fixed);
+    }
+
+    return Testing::result();
+}
@@ -0,0 +1,107 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Batch tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          A batch of short and long series, scalar and vector, against each series counted alone as Probabilities
+//  does, with the seed seed + s: the rows must be equal, sampled and exhaustive. A structure in the dictionary
+//  mode, or too large for a dense row, and a series shorter than the structure must be rejected before counting.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+#include "batch.h"
+#include "counting.h"
+#include "scan.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+
+#define SEED 21
+#define THRESHOLD 0.4
+#define RATE 0.3
+//      -------------------------------------------------------------------------------------------------------
+//              * The probabilities of one series alone.
+std::vector<double> alone(const Settings &settings, const SeriesView &view, const uint64_t seed, const bool exhaustive) {
+    const Stencil stencil(settings, view.strides, view.strides, view.dims[0]);
+    const Sampler sampler(settings, view.dims, view.dims, RATE, seed);
+    const Recurrence recurrence(METRIC_EUCLIDEAN, THRESHOLD, view.dims[0], settings.specialization());
+
+    std::vector<double> result;
+    if (exhaustive) {
+        const Scan scan(settings, view.data, view.dims, view.strides, view.data, view.dims, view.strides, recurrence);
+        histogram_dense(settings, scan.rows(), SCAN_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+            return scan(begin, end, count);
+        }, result);
+    } else
+        histogram_dense(settings, sampler.size(), DEFAULT_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+            return count_microstates(sampler, begin, end, stencil, view.data, view.data, recurrence, count);
+        }, result);
+
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename F> bool rejects(F &&call) {
+    try {
+        call();
+    } catch (const std::invalid_argument &) {
+        return true;
+    }
+    return false;
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    std::mt19937_64 generator(5);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    //      Scalar series of several lengths, one of them long enough to be split between the threads, and a
+    //  (vector, time) series stored as (time, vector).
+    std::vector<std::vector<double>> data;
+    std::vector<SeriesView> series;
+    for (const size_t length : {40, 300, 2500, 1000}) {
+        auto &values = data.emplace_back(length);
+        for (auto &v : values) v = uniform(generator);
+        series.push_back({values.data(), {1, length}, {0, 1}});
+    }
+    auto &vector = data.emplace_back(2 * 500);
+    for (auto &v : vector) v = uniform(generator);
+    series.push_back({vector.data(), {2, 500}, {1, 2}});
+
+    for (const auto &structure : {std::vector<size_t>{2, 2}, std::vector<size_t>{3, 2}})
+        for (const bool exhaustive : {false, true}) {
+            const Settings settings(structure, std::thread::hardware_concurrency(), MODE_FORCE_VECTOR);
+            const auto possibilities = settings.possibilities();
+
+            std::vector<double> output(series.size() * possibilities);
+            count_batch(settings, series, METRIC_EUCLIDEAN, THRESHOLD, RATE, SEED, exhaustive, output.data());
+
+            for (size_t s = 0; s < series.size(); s++) {
+                const auto expected = alone(settings, series[s], SEED + s, exhaustive);
+                const std::vector<double> row(output.begin() + static_cast<std::ptrdiff_t>(s * possibilities),
+                    output.begin() + static_cast<std::ptrdiff_t>((s + 1) * possibilities));
+                if (!CHECK(row == expected)) std::printf("    series %zu, structure %zu x %zu, exhaustive %d\n", s, structure[0], structure[1], exhaustive);
+            }
+        }
+
+    //      The checks that must come before the (series, 2^hypervolume) output is allocated.
+    CHECK(rejects([&] { check_batch(Settings({6, 6}, 1), series); }));
+    CHECK(rejects([&] { check_batch(Settings({8, 8}, 1, MODE_FORCE_VECTOR), series); }));
+    CHECK(rejects([&] { check_batch(Settings({2, 2, 2, 2}, 1), series); }));
+    CHECK(rejects([&] { check_batch(Settings({50, 1}, 1), series); }));
+    CHECK(!rejects([&] { check_batch(Settings({2, 2}, 1), series); }));
+
+    return Testing::result();
+}
@@ -0,0 +1,84 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Recurrence matrix tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          RecurrenceMatrix against the microstates of the stencil at every position of the recurrence plot, for
+//  lengths that are not multiples of 64: the gathers across two words, from the padding word at the end of a row,
+//  across the 64 x 64 words tiles and up to the last row and column. Then a cross recurrence whose x series is
+//  stored as (time, vector) and y as (vector, time).
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "matrix.h"
+#include "settings.h"
+#include "stencil.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+
+#define THRESHOLD 1.5
+//      -------------------------------------------------------------------------------------------------------
+void check_matrix(const std::vector<std::vector<size_t>> &structures, const size_t vector, const size_t size_x, const size_t size_y,
+    const bool transposed) {
+
+    std::mt19937_64 generator(7);
+    std::uniform_int_distribution<int> pick(0, 3);
+
+    std::vector<double> x(vector * size_x), y(vector * size_y);
+    for (auto &v : x) v = pick(generator);
+    for (auto &v : y) v = pick(generator);
+
+    const std::vector<size_t> dims_x{vector, size_x}, dims_y{vector, size_y};
+    const std::vector<std::ptrdiff_t> strides_x{1, static_cast<std::ptrdiff_t>(vector)};
+    const std::vector<std::ptrdiff_t> strides_y = transposed ? std::vector<std::ptrdiff_t>{static_cast<std::ptrdiff_t>(size_y), 1} : strides_x;
+
+    const RecurrenceMatrix matrix(x.data(), dims_x, strides_x, y.data(), dims_y, strides_y, METRIC_EUCLIDEAN, THRESHOLD,
+        std::thread::hardware_concurrency());
+    CHECK(matrix.columns() == size_x && matrix.rows() == size_y);
+
+    for (const auto &structure : structures) {
+        const Settings settings(structure, 1, MODE_FORCE_DICTIONARY);
+        const Stencil stencil(settings, strides_x, strides_y, vector);
+        const Recurrence recurrence(METRIC_EUCLIDEAN, THRESHOLD, vector, settings.specialization());
+
+        size_t wrong = 0;
+        for (size_t j = 0; j + structure[1] <= size_y; j++)
+            for (size_t i = 0; i + structure[0] <= size_x; i++) {
+                const size_t sample[] = {i, j};
+                const auto expected = recurrence(x.data() + stencil.base_x(sample), stencil.offsets_x(), stencil.step_x(),
+                    y.data() + stencil.base_y(sample), stencil.offsets_y(), stencil.step_y(), stencil.cells());
+                wrong += matrix.microstate(i, j, structure[0], structure[1]) != expected;
+            }
+
+        if (!CHECK(wrong == 0))
+            std::printf("    %zu wrong, structure %zu x %zu, vector %zu, size %zu x %zu\n", wrong, structure[0], structure[1], vector, size_x, size_y);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    const std::vector<std::vector<size_t>> structures{{1, 1}, {2, 2}, {3, 5}, {7, 2}, {8, 8}, {64, 1}, {33, 1}};
+
+    //      Shorter than a word, a single tile with a partial last word, and two tiles of rows and of words.
+    check_matrix(structures, 1, 37, 50, false);
+    check_matrix(structures, 1, 200, 70, false);
+    check_matrix(structures, 2, 4096 + 101, 131, false);
+
+    //      A cross recurrence of series of different lengths and layouts.
+    check_matrix(structures, 3, 150, 97, true);
+
+    return Testing::result();
+}
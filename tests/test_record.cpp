@@ -0,0 +1,150 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Histogram record tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          The shards of a seed, each one a share [k * count / n, (k + 1) * count / n) of its samples as in
+//  Probabilities, merged in any order must give the record of a single run. The bytes of a record must give it
+//  back. Records that do not combine, keys out of order, damaged bytes and the NaN threshold of a user function
+//  must be rejected.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <bit>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+#include "counting.h"
+#include "record.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+
+#define SERIES 20000
+#define SEED 11
+#define THRESHOLD 0.5
+//      -------------------------------------------------------------------------------------------------------
+bool same(const HistogramRecord &a, const HistogramRecord &b) {
+    return a.structure() == b.structure() && a.metric() == b.metric() && a.threshold() == b.threshold() && a.samples() == b.samples() &&
+           a.seed() == b.seed() && a.dictionary() == b.dictionary() && a.keys() == b.keys() && a.counts() == b.counts();
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Whether making or merging a record is rejected as an invalid argument.
+template<typename F> bool rejects(F &&make) {
+    try {
+        make();
+    } catch (const std::invalid_argument &) {
+        return true;
+    }
+    return false;
+}
+//      -------------------------------------------------------------------------------------------------------
+void check_shards(const bool dictionary) {
+    std::mt19937_64 generator(3);
+    std::normal_distribution<double> normal;
+    std::vector<double> series(SERIES);
+    for (auto &v : series) v = normal(generator);
+
+    const Settings settings({3, 3}, std::thread::hardware_concurrency(), dictionary ? MODE_FORCE_DICTIONARY : MODE_FORCE_VECTOR);
+    const std::vector<std::ptrdiff_t> strides{1, 1};
+    const Stencil stencil(settings, strides, strides, 1);
+    const Recurrence recurrence(METRIC_EUCLIDEAN, THRESHOLD, 1, settings.specialization());
+    const Sampler sampler(settings, {1, SERIES}, {1, SERIES}, 0.2, SEED);
+
+    //      The shard k of n.
+    const auto run = [&](const size_t k, const size_t n) {
+        const auto first = sampler.size() * k / n;
+        const auto last = sampler.size() * (k + 1) / n;
+        const auto task = [&](const size_t begin, const size_t end, auto &&count) {
+            return count_microstates(sampler, first + begin, first + end, stencil, series.data(), series.data(), recurrence, count);
+        };
+
+        std::vector<uint64_t> keys;
+        std::vector<size_t> counts;
+        size_t used;
+        if (dictionary) {
+            FlatHistogram histogram;
+            used = count_sparse(settings, last - first, DEFAULT_CHUNK, task, histogram);
+            histogram.sorted(keys, counts);
+        } else used = count_dense(settings, last - first, DEFAULT_CHUNK, task, counts);
+
+        return HistogramRecord({3, 3}, METRIC_EUCLIDEAN, THRESHOLD, used, SEED, dictionary, keys, {counts.begin(), counts.end()});
+    };
+
+    const auto full = run(0, 1);
+    const auto a = run(0, 3), b = run(1, 3), c = run(2, 3);
+    CHECK(same(a.merge(b).merge(c), full));
+    CHECK(same(a.merge(b.merge(c)), full));
+    CHECK(same(c.merge(a).merge(b), full));
+
+    //      The bytes round trip, and the probabilities of the record.
+    const HistogramRecord back(full.bytes());
+    CHECK(same(back, full) && back.bytes() == full.bytes());
+
+    double sum = 0.0;
+    for (const auto p : full.probabilities()) sum += p;
+    CHECK(std::abs(sum - 1.0) < 1e-12);
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    check_shards(false);
+    check_shards(true);
+
+    //      A dense and a sparse record of different seeds: the result is dense, and its seed says it was mixed.
+    std::vector<uint64_t> counts(16, 0);
+    counts[3] = 2;
+    counts[5] = 1;
+    const HistogramRecord dense({2, 2}, METRIC_EUCLIDEAN, 0.1, 3, 1, false, {}, counts);
+    const HistogramRecord sparse({2, 2}, METRIC_EUCLIDEAN, 0.1, 4, 2, true, {3, 9}, {1, 3});
+    const auto merged = dense.merge(sparse);
+    CHECK(!merged.dictionary() && merged.samples() == 7 && merged.seed() == RECORD_MIXED_SEED);
+    CHECK(merged.counts()[3] == 3 && merged.counts()[5] == 1 && merged.counts()[9] == 3);
+    CHECK(merged.counts() == sparse.merge(dense).counts());
+
+    CHECK(rejects([&] { (void)HistogramRecord({2, 2}, METRIC_EUCLIDEAN, 0.2, 1, 1, false, {}, counts).merge(dense); }));
+    CHECK(rejects([&] { (void)HistogramRecord({2, 2}, METRIC_EUCLIDEAN, 0.1, 2, 1, true, {9, 3}, {1, 1}); }));
+    CHECK(rejects([&] { (void)HistogramRecord({2, 2}, METRIC_EUCLIDEAN, 0.1, 2, 1, true, {3, 3}, {1, 1}); }));
+    CHECK(rejects([&] {
+        auto bytes = dense.bytes();
+        bytes.pop_back();
+        (void)HistogramRecord(bytes);
+    }));
+    CHECK(rejects([&] { (void)HistogramRecord(std::string("XXXX")); }));
+    //      The NaN threshold of a run with a user function, directly and from bytes, so no two of them can merge.
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK(rejects([&] { (void)HistogramRecord({2, 2}, METRIC_EUCLIDEAN, nan, 3, 1, false, {}, counts); }));
+    CHECK(rejects([&] {
+        //      The threshold comes after the magic, the version, the mode, the metric, the dimensions and two sizes.
+        auto bytes = dense.bytes();
+        const auto bits = std::bit_cast<uint64_t>(nan);
+        for (size_t b = 0; b < 8; b++) bytes[28 + b] = static_cast<char>(bits >> (8 * b) & 0xFF);
+        (void)HistogramRecord(bytes);
+    }));
+
+    CHECK(rejects([&] { (void)HistogramRecord({0}, METRIC_EUCLIDEAN, 0.1, 0, 1, true, {}, {}); }));
+    CHECK(rejects([&] { (void)HistogramRecord({size_t{1} << 32, size_t{1} << 32}, METRIC_EUCLIDEAN, 0.1, 0, 1, true, {}, {}); }));
+    CHECK(rejects([&] {
+        //      The two sizes of an empty sparse record, after the magic, the version, the mode, the metric and their
+        //  count, set to 2^32: their product wraps to 0.
+        auto bytes = HistogramRecord({2, 2}, METRIC_EUCLIDEAN, 0.1, 0, 1, true, {}, {}).bytes();
+        for (const size_t at : {12, 20}) bytes[at + 4] = 1;
+        bytes[12] = bytes[20] = 0;
+        (void)HistogramRecord(bytes);
+    }));
+
+    return Testing::result();
+}
@@ -0,0 +1,115 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Typed recurrence tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          The kernels of each data type against a plain evaluation of the distances in 128 bits integers (or
+//  double for float32 data with integer values, which is exact). The data mixes equal values with the extremes
+//  of the type, so the Euclidean distance of int32 overflows 64 bits when it is not saturated. With 9, 16 and 64
+//  cells both the vectorized lanes and the scalar tail are used.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "recurrence.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+//      -------------------------------------------------------------------------------------------------------
+//              * Values of the data: small ones, which recur, and the extremes of the type.
+template<typename T> std::vector<T> values() {
+    if constexpr (std::is_floating_point_v<T>) return {-3, -2, -1, 0, 1, 2, 3};
+    else {
+        constexpr auto low = std::numeric_limits<T>::min();
+        constexpr auto high = std::numeric_limits<T>::max();
+        return {low, static_cast<T>(low + 1), 0, 1, 2, static_cast<T>(high - 1), high};
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * The recurrence of one cell, evaluated plainly.
+template<typename T> bool recurs(const T *x, const T *y, const size_t length, const unsigned short metric, const double threshold) {
+    if (threshold < 0) return false;
+
+    __int128 distance = 0;
+    double real = 0.0;
+    for (size_t k = 0; k < length; k++) {
+        const auto diff = static_cast<__int128>(x[k]) - static_cast<__int128>(y[k]);
+        const auto magnitude = diff < 0 ? -diff : diff;
+        if (metric == METRIC_EUCLIDEAN) distance += diff * diff;
+        else if (metric == METRIC_CHEBYSHEV) distance = std::max(distance, magnitude);
+        else distance += magnitude;
+
+        const auto difference = static_cast<double>(x[k]) - static_cast<double>(y[k]);
+        if (metric == METRIC_EUCLIDEAN) real += difference * difference;
+        else if (metric == METRIC_CHEBYSHEV) real = std::max(real, std::abs(difference));
+        else real += std::abs(difference);
+    }
+
+    const auto limit = metric == METRIC_EUCLIDEAN ? threshold * threshold : threshold;
+    if constexpr (std::is_floating_point_v<T>) return real <= limit;
+    else return distance <= static_cast<__int128>(std::floor(limit));
+}
+//      -------------------------------------------------------------------------------------------------------
+template<typename T> void check_type(std::mt19937_64 &generator) {
+    const auto pool = values<T>();
+    std::uniform_int_distribution<size_t> pick(0, pool.size() - 1);
+
+    for (const size_t length : {1, 2, 3, 5})
+        for (const size_t cells : {9, 16, 64}) {
+            //      Each cell compares its own x and y vectors, stored one after the other with a step of one.
+            std::vector<T> x(cells * length), y(cells * length);
+            for (auto &v : x) v = pool[pick(generator)];
+            for (auto &v : y) v = pool[pick(generator)];
+
+            std::vector<std::ptrdiff_t> offsets(cells);
+            for (size_t m = 0; m < cells; m++) offsets[m] = static_cast<std::ptrdiff_t>(m * length);
+
+            for (const unsigned short metric : {METRIC_EUCLIDEAN, METRIC_CHEBYSHEV, METRIC_MANHATTAN})
+                for (const double threshold : {-1.0, 0.0, 0.5, 1.0, 2.5, 4.0, 1e5, 1e10}) {
+                    const BasicRecurrence<T> recurrence(metric, threshold, length);
+                    const auto bits = recurrence(x.data(), offsets.data(), 1, y.data(), offsets.data(), 1, cells);
+
+                    uint64_t expected = 0;
+                    for (size_t m = 0; m < cells; m++)
+                        expected |= static_cast<uint64_t>(recurs(x.data() + m * length, y.data() + m * length, length, metric, threshold)) << m;
+
+                    if (!CHECK(bits == expected))
+                        std::printf("    size %zu, length %zu, cells %zu, metric %u, threshold %g\n", sizeof(T), length, cells, metric, threshold);
+                }
+        }
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    std::mt19937_64 generator(16);
+
+    //      The int32 extremes: the squared difference is about 2^64, it must not wrap to a small distance.
+    constexpr auto low = std::numeric_limits<int32_t>::min();
+    constexpr auto high = std::numeric_limits<int32_t>::max();
+    const int32_t far_x[] = {high, high}, far_y[] = {low, low};
+    const int32_t near_x[] = {high, low}, near_y[] = {high - 1, low};
+    const std::ptrdiff_t zero[] = {0};
+    const BasicRecurrence<int32_t> euclidean(METRIC_EUCLIDEAN, 10.0, 2);
+    CHECK(euclidean(far_x, zero, 1, far_y, zero, 1, 1) == 0);
+    CHECK(euclidean(near_x, zero, 1, near_y, zero, 1, 1) == 1);
+
+    check_type<float>(generator);
+    check_type<int32_t>(generator);
+    check_type<int16_t>(generator);
+    check_type<uint8_t>(generator);
+
+    return Testing::result();
+}
@@ -0,0 +1,74 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Sampler tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          The Philox4x32-10 generator against the known answers of its reference implementation (Random123), so
+//  a seed gives the same samples on every machine. Two Samplers of the same seed must draw the same sequence, in
+//  any order and whether tiled or not, and another seed a different one.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "sampler.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+//      -------------------------------------------------------------------------------------------------------
+//              * The samples of a Sampler in order, each one as its dimensions() values.
+std::vector<size_t> sequence(const Sampler &sampler) {
+    std::vector<size_t> result(sampler.size() * sampler.dimensions());
+    auto cursor = sampler.cursor();
+    for (size_t i = 0; i < sampler.size(); i++) sampler(i, result.data() + i * sampler.dimensions(), cursor);
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+void check_seed(const std::vector<size_t> &structure, const std::vector<size_t> &dims, const std::vector<size_t> &tiles) {
+    const Settings settings(structure, 1);
+    const Sampler a(settings, dims, dims, 0.05, 1234, tiles, tiles);
+    const Sampler b(settings, dims, dims, 0.05, 1234, tiles, tiles);
+    const Sampler other(settings, dims, dims, 0.05, 1235, tiles, tiles);
+
+    const auto expected = sequence(a);
+    CHECK(a.size() == b.size() && a.seed() == 1234 && expected == sequence(b) && expected != sequence(other));
+
+    //      Backwards and without a cursor, as a thread that starts anywhere.
+    std::vector<size_t> sample(a.dimensions());
+    bool same = true;
+    for (auto i = a.size(); i-- > 0;) {
+        b(i, sample.data());
+        for (size_t d = 0; d < sample.size(); d++) same = same && sample[d] == expected[i * sample.size() + d];
+    }
+    if (!CHECK(same)) std::printf("    %zu dimensions, %zu tiles\n", dims.size(), tiles.size());
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    //      The counter, the key and the block of each known answer.
+    const std::array<uint32_t, 4> zero{0, 0, 0, 0}, ones{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const std::array<uint32_t, 4> digits{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const std::array<uint32_t, 4> zero_block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    const std::array<uint32_t, 4> ones_block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+    const std::array<uint32_t, 4> digits_block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+
+    CHECK(Sampler::philox(zero, 0) == zero_block);
+    CHECK(Sampler::philox(ones, 0xffffffffffffffff) == ones_block);
+    CHECK(Sampler::philox(digits, 0x299f31d0a4093822) == digits_block);
+
+    check_seed({3, 3}, {1, 2000}, {});
+    check_seed({3, 3}, {1, 2000}, {100});
+    check_seed({2, 2, 2, 2}, {1, 120, 90}, {});
+    check_seed({2, 2, 2, 2}, {1, 120, 90}, {16, 16});
+
+    return Testing::result();
+}
@@ -0,0 +1,122 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Exhaustive scan tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          Scan against the microstates of the sampled path, evaluated by the stencil at every position of the
+//  recurrence plot: the histograms must be equal, for square and rectangular structures, vector data, cross
+//  recurrences of series of different lengths, each metric and each data type. A sampled run over the same series
+//  must then give about the same distribution.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <map>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "counting.h"
+#include "scan.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+//      -------------------------------------------------------------------------------------------------------
+//              * The series are stored as (time, vector), so the vector values of a point are one after the other.
+template<typename T> void check_scan(const std::vector<size_t> &structure, const size_t vector, const size_t size_x, const size_t size_y,
+    const unsigned short metric, const double threshold) {
+
+    std::mt19937_64 generator(11);
+    std::uniform_int_distribution<int> pick(0, 4);
+
+    std::vector<T> x(vector * size_x), y(vector * size_y);
+    for (auto &v : x) v = static_cast<T>(pick(generator));
+    for (auto &v : y) v = static_cast<T>(pick(generator));
+
+    const std::vector<size_t> dims_x{vector, size_x}, dims_y{vector, size_y};
+    const std::vector<std::ptrdiff_t> strides{1, static_cast<std::ptrdiff_t>(vector)};
+
+    const Settings settings(structure, 1, MODE_FORCE_DICTIONARY);
+    const BasicRecurrence<T> recurrence(metric, threshold, vector, settings.specialization());
+    const BasicScan<T> scan(settings, x.data(), dims_x, strides, y.data(), dims_y, strides, recurrence);
+
+    std::map<uint64_t, size_t> counted;
+    const auto total = scan(0, scan.rows(), [&](const uint64_t microstate) { counted[microstate]++; });
+
+    //      The rows counted in slices, as the tasks of the pool take them.
+    std::map<uint64_t, size_t> sliced;
+    for (size_t row = 0; row < scan.rows(); row += 5)
+        scan(row, std::min(scan.rows(), row + 5), [&](const uint64_t microstate) { sliced[microstate]++; });
+
+    //      The microstate of the sampled path at each position of the plot.
+    const Stencil stencil(settings, strides, strides, vector);
+    std::map<uint64_t, size_t> expected;
+    size_t positions = 0;
+    for (size_t j = 0; j + structure[1] <= size_y; j++)
+        for (size_t i = 0; i + structure[0] <= size_x; i++, positions++) {
+            const size_t sample[] = {i, j};
+            expected[recurrence(x.data() + stencil.base_x(sample), stencil.offsets_x(), stencil.step_x(),
+                y.data() + stencil.base_y(sample), stencil.offsets_y(), stencil.step_y(), stencil.cells())]++;
+        }
+
+    if (!CHECK(total == positions && scan.size() == positions && counted == expected && sliced == expected))
+        std::printf("    size %zu, structure %zu x %zu, vector %zu, metric %u\n", sizeof(T), structure[0], structure[1], vector, metric);
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * A sampled run over a series and its scan: the probabilities differ only by the sampling error.
+void check_sampled() {
+    const size_t size = 400;
+    std::mt19937_64 generator(3);
+    std::normal_distribution<double> normal;
+    std::vector<double> series(size);
+    for (auto &v : series) v = normal(generator);
+
+    const Settings settings({2, 2}, std::thread::hardware_concurrency(), MODE_FORCE_VECTOR);
+    const std::vector<std::ptrdiff_t> strides{1, 1};
+    const Stencil stencil(settings, strides, strides, 1);
+    const Sampler sampler(settings, {1, size}, {1, size}, 1.0, 5);
+    const Recurrence recurrence(METRIC_EUCLIDEAN, 0.5, 1, settings.specialization());
+    const Scan scan(settings, series.data(), {1, size}, strides, series.data(), {1, size}, strides, recurrence);
+
+    std::vector<double> exhaustive, sampled;
+    const auto scanned = histogram_dense(settings, scan.rows(), SCAN_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+        return scan(begin, end, count);
+    }, exhaustive);
+    const auto drawn = histogram_dense(settings, sampler.size(), DEFAULT_CHUNK, [&](const size_t begin, const size_t end, auto &&count) {
+        return count_microstates(sampler, begin, end, stencil, series.data(), series.data(), recurrence, count);
+    }, sampled);
+
+    double distance = 0.0;
+    for (size_t i = 0; i < exhaustive.size(); i++) distance = std::max(distance, std::abs(exhaustive[i] - sampled[i]));
+    CHECK(scanned == scan.size() && drawn == sampler.size() && distance < 0.01);
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    for (const unsigned short metric : {METRIC_EUCLIDEAN, METRIC_CHEBYSHEV, METRIC_MANHATTAN}) {
+        check_scan<double>({2, 2}, 1, 150, 150, metric, 1.0);
+        check_scan<double>({3, 3}, 3, 140, 130, metric, 2.0);
+        check_scan<double>({4, 2}, 2, 90, 200, metric, 1.5);
+        check_scan<double>({1, 5}, 1, 70, 80, metric, 0.5);
+    }
+
+    //      Rows longer than a word, the largest microstate and the other data types.
+    check_scan<double>({8, 8}, 1, 200, 100, METRIC_EUCLIDEAN, 2.0);
+    check_scan<float>({3, 3}, 2, 130, 120, METRIC_EUCLIDEAN, 1.5);
+    check_scan<int32_t>({2, 3}, 1, 100, 110, METRIC_MANHATTAN, 1.0);
+    check_scan<int16_t>({3, 2}, 3, 100, 90, METRIC_CHEBYSHEV, 1.0);
+    check_scan<uint8_t>({2, 2}, 1, 130, 130, METRIC_EUCLIDEAN, 0.0);
+
+    check_sampled();
+
+    return Testing::result();
+}
@@ -0,0 +1,94 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Settings and stencil tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          The cells of a microstate come in odometer order, the first dimension running faster: the cell m has
+//  the index (m / (s0 * ... * s(k-1))) % sk along the dimension k, so every index of the structure appears once,
+//  and the carry takes the next dimension exactly when one reaches its size. The Stencil keeps that order in its
+//  offsets, and the cell a + patch_x * b compares the x point a with the y point b.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+#include "settings.h"
+#include "stencil.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+//      -------------------------------------------------------------------------------------------------------
+void check_order(const std::vector<size_t> &structure) {
+    const Settings settings(structure, 1);
+    const auto dimensions = structure.size();
+    const auto &cells = settings.stencil();
+
+    size_t hypervolume = 1;
+    for (const auto s : structure) hypervolume *= s;
+    CHECK(settings.get_hypervolume() == hypervolume && cells.size() == hypervolume * dimensions);
+
+    for (size_t m = 0; m < hypervolume; m++) {
+        size_t below = 1;
+        for (size_t k = 0; k < dimensions; k++) {
+            if (!CHECK(cells[m * dimensions + k] == m / below % structure[k]))
+                std::printf("    structure of %zu dimensions, cell %zu, dimension %zu\n", dimensions, m, k);
+            below *= structure[k];
+        }
+    }
+
+    //      The offsets on data with (vector, d1, ...) strides that are not the ones of a contiguous tensor.
+    const auto half = dimensions / 2;
+    std::vector<std::ptrdiff_t> strides_x{1}, strides_y{2};
+    for (size_t k = 0; k < half; k++) {
+        strides_x.push_back(static_cast<std::ptrdiff_t>(3 + 100 * k));
+        strides_y.push_back(static_cast<std::ptrdiff_t>(7 + 1000 * k));
+    }
+
+    const Stencil stencil(settings, strides_x, strides_y, 1);
+    CHECK(stencil.cells() == hypervolume && stencil.dimensions() == half);
+    for (size_t m = 0; m < hypervolume; m++) {
+        std::ptrdiff_t x = 0, y = 0;
+        for (size_t k = 0; k < half; k++) {
+            x += static_cast<std::ptrdiff_t>(cells[m * dimensions + k]) * strides_x[k + 1];
+            y += static_cast<std::ptrdiff_t>(cells[m * dimensions + half + k]) * strides_y[k + 1];
+        }
+
+        CHECK(stencil.offsets_x()[m] == x && stencil.offsets_y()[m] == y);
+        CHECK(stencil.patch_x()[m % settings.patch_x()] == x && stencil.patch_y()[m / settings.patch_x()] == y);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    check_order({1, 1});
+    check_order({2, 2});
+    check_order({4, 1});
+    check_order({1, 5});
+    check_order({3, 1, 2, 2});
+    check_order({2, 3, 4, 1});
+    check_order({1, 2, 3, 2, 1, 2});
+    check_order({4, 4, 2, 2});
+    check_order({8, 8});
+
+    //      The structures that cannot be a microstate.
+    const auto rejects = [](const std::vector<size_t> &structure) {
+        try {
+            const Settings settings(structure, 1);
+        } catch (const std::invalid_argument &) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(rejects({2}) && rejects({2, 2, 2}) && rejects({2, 0}) && rejects({8, 9}));
+
+    return Testing::result();
+}
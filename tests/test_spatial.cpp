@@ -0,0 +1,190 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Spatial fields tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          The exhaustive engine of 2-D and 3-D fields against a brute-force walk over every microstate with the
+//  stencil, for mixed structures, Fortran ordered data and each data type. Then the tiled order of the sampled
+//  mode on a field: the samples stay in their block, each pair of blocks gets its share of them, and drawing them
+//  with a cursor gives the same samples.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <map>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+
+#include "spatial.h"
+#include "stencil.h"
+#include "sampler.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+//      -------------------------------------------------------------------------------------------------------
+//              * Strides of a C ordered (the last dimension is contiguous) or Fortran ordered field.
+std::vector<std::ptrdiff_t> strides(const std::vector<size_t> &dims, const bool fortran) {
+    std::vector<std::ptrdiff_t> result(dims.size());
+    std::ptrdiff_t step = 1;
+    for (size_t k = 0; k < dims.size(); k++) {
+        const auto d = fortran ? k : dims.size() - 1 - k;
+        result[d] = step;
+        step *= static_cast<std::ptrdiff_t>(dims[d]);
+    }
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Every microstate of the fields, by the engine and by the brute-force walk.
+template<typename T> void check_exhaustive(const std::vector<size_t> &structure, const std::vector<size_t> &dims_x,
+    const std::vector<size_t> &dims_y, const double threshold, const bool fortran) {
+
+    std::mt19937_64 generator(7);
+    std::uniform_int_distribution<int> pick(0, 6);
+
+    size_t points_x = 1, points_y = 1;
+    for (const auto d : dims_x) points_x *= d;
+    for (const auto d : dims_y) points_y *= d;
+
+    std::vector<T> x(points_x), y(points_y);
+    for (auto &v : x) v = static_cast<T>(pick(generator));
+    for (auto &v : y) v = static_cast<T>(pick(generator));
+
+    const auto strides_x = strides(dims_x, false);
+    const auto strides_y = strides(dims_y, fortran);
+
+    const Settings settings(structure, 1, MODE_FORCE_DICTIONARY);
+    const BasicRecurrence<T> recurrence(METRIC_EUCLIDEAN, threshold, dims_x[0]);
+    const BasicSpatial<T> spatial(settings, x.data(), dims_x, strides_x, y.data(), dims_y, strides_y, recurrence);
+
+    std::map<uint64_t, size_t> counted;
+    const auto total = spatial(0, spatial.rows(), [&](const uint64_t microstate) { counted[microstate]++; });
+
+    //      The brute force: an odometer over the positions, the first dimension running faster.
+    const Stencil stencil(settings, strides_x, strides_y, dims_x[0]);
+    const auto dims = dims_x.size() - 1;
+    std::vector<size_t> ranges(2 * dims);
+    for (size_t d = 0; d < dims; d++) {
+        ranges[d] = dims_x[d + 1] - structure[d] + 1;
+        ranges[dims + d] = dims_y[d + 1] - structure[dims + d] + 1;
+    }
+
+    std::map<uint64_t, size_t> expected;
+    size_t positions = 0;
+    std::vector<size_t> sample(2 * dims, 0);
+    for (size_t k = 0; k < sample.size(); positions++) {
+        expected[recurrence(x.data() + stencil.base_x(sample.data()), stencil.offsets_x(), stencil.step_x(),
+            y.data() + stencil.base_y(sample.data()), stencil.offsets_y(), stencil.step_y(), stencil.cells())]++;
+
+        for (k = 0; k < sample.size(); k++) {
+            if (++sample[k] < ranges[k]) break;
+            sample[k] = 0;
+        }
+    }
+
+    //      The rows counted in arbitrary slices give the same histogram.
+    std::map<uint64_t, size_t> sliced;
+    size_t slices = 0;
+    for (size_t row = 0; row < spatial.rows(); row += 7)
+        slices += spatial(row, std::min(spatial.rows(), row + 7), [&](const uint64_t microstate) { sliced[microstate]++; });
+
+    if (!CHECK(total == positions && spatial.size() == positions && counted == expected && sliced == expected && slices == positions))
+        std::printf("    size %zu, dimensions %zu, structure %zu x %zu\n", sizeof(T), dims, structure[0], structure[1]);
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * The tiled order of the samples on a field cut in blocks.
+void check_tiled(const std::vector<size_t> &tiles) {
+    const std::vector<size_t> dims{1, 40, 50};
+    const Settings settings({2, 3, 3, 2}, 1);
+    const Sampler plain(settings, dims, dims, 0.01, 5);
+    const Sampler tiled(settings, dims, dims, 0.01, 5, tiles, tiles);
+    CHECK(tiled.tiled() && !plain.tiled() && tiled.size() == plain.size());
+
+    const std::vector<size_t> ranges{39, 48, 38, 49};
+    std::vector<size_t> lengths(4), blocks(4);
+    for (size_t d = 0; d < 4; d++) {
+        lengths[d] = tiles[d % 2] == 0 ? ranges[d] : tiles[d % 2];
+        blocks[d] = (ranges[d] + lengths[d] - 1) / lengths[d];
+    }
+
+    //      The samples of each pair of blocks, and the pair of the previous sample: they come pair by pair.
+    std::map<std::vector<size_t>, size_t> pairs;
+    std::vector<size_t> sample(4), fresh(4), previous;
+    size_t changes = 0;
+    auto cursor = tiled.cursor();
+    for (size_t i = 0; i < tiled.size(); i++) {
+        tiled(i, sample.data(), cursor);
+        tiled(i, fresh.data());
+        CHECK(sample == fresh);
+
+        std::vector<size_t> pair(4);
+        for (size_t d = 0; d < 4; d++) {
+            CHECK(sample[d] < ranges[d]);
+            pair[d] = sample[d] / lengths[d];
+        }
+        changes += pair != previous;
+        previous = pair;
+        pairs[pair]++;
+    }
+
+    //      Each pair has its share of the samples, within one.
+    double area = 1.0;
+    for (const auto range : ranges) area *= static_cast<double>(range);
+    size_t visited = 0;
+    std::vector<size_t> pair(4, 0);
+    for (size_t k = 0; k < pair.size(); visited++) {
+        double share = static_cast<double>(tiled.size()) / area;
+        for (size_t d = 0; d < 4; d++) share *= static_cast<double>(std::min(lengths[d], ranges[d] - pair[d] * lengths[d]));
+        CHECK(std::abs(static_cast<double>(pairs.contains(pair) ? pairs[pair] : 0) - share) <= 1.0);
+
+        for (k = 0; k < pair.size(); k++) {
+            if (++pair[k] < blocks[k]) break;
+            pair[k] = 0;
+        }
+    }
+    CHECK(changes <= visited);
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    check_exhaustive<double>({2, 2, 2, 2}, {1, 9, 11}, {1, 9, 11}, 1.5, false);
+    check_exhaustive<double>({3, 2, 2, 3}, {2, 8, 9}, {2, 10, 7}, 2.5, false);
+    check_exhaustive<double>({2, 3, 1, 2}, {1, 7, 8}, {1, 9, 6}, 1.0, true);
+    check_exhaustive<double>({1, 2, 3, 2, 1, 2}, {2, 4, 5, 6}, {2, 5, 4, 5}, 2.0, true);
+    check_exhaustive<float>({1, 4, 2, 2}, {1, 6, 9}, {1, 6, 9}, 1.0, false);
+    check_exhaustive<int32_t>({2, 2, 2, 2}, {1, 9, 11}, {1, 8, 10}, 2.0, true);
+    check_exhaustive<int16_t>({2, 2, 2, 2, 2, 2}, {1, 5, 6, 7}, {1, 6, 5, 4}, 2.0, false);
+    check_exhaustive<uint8_t>({2, 2, 2, 2}, {1, 9, 11}, {1, 9, 11}, 0.0, false);
+
+    //      Time series go to Scan, not to the fields engine.
+    try {
+        const Settings settings({2, 2}, 1);
+        const Recurrence recurrence(METRIC_EUCLIDEAN, 1.0, 1);
+        const std::vector<double> series(10);
+        const Spatial spatial(settings, series.data(), {1, 10}, {10, 1}, series.data(), {1, 10}, {10, 1}, recurrence);
+        CHECK(false);
+    } catch (const std::invalid_argument &) {}
+
+    //      Blocks on both dimensions, strips along the last one and blocks along the first one only.
+    check_tiled({8, 10});
+    check_tiled({0, 7});
+    check_tiled({6, 0});
+
+    //      The tile shapes: strips of whole lines while they fit, blocks otherwise.
+    CHECK(tile_lengths({1, 100000000}, 8) == std::vector<size_t>({16384}));
+    CHECK(tile_lengths({1, 512, 512}, 8) == std::vector<size_t>({512, 32}));
+    CHECK(tile_lengths({1, 4096, 4096}, 8) == std::vector<size_t>({128, 128}));
+    CHECK(tile_lengths({1, 256, 256, 256}, 8) == std::vector<size_t>({256, 8, 8}));
+
+    return Testing::result();
+}
@@ -0,0 +1,154 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Streaming tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          A Stream fed in chunks of several sizes against the histogram recomputed from the points it has seen:
+//  with expire, only the microstates inside the last window points; without it, every microstate that fitted in
+//  a window when its last point arrived. Then two threads pushing into the same Stream while a third one reads.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <map>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "stream.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+//      -------------------------------------------------------------------------------------------------------
+//              * The microstates of the points, as (time, vector) values, with the first point at first and whose
+//  points span at most window: the bit a + b * patch_x is the recurrence of the x point i + a with the y point j + b.
+std::map<uint64_t, size_t> recompute(const std::vector<double> &points, const size_t vector, const size_t first, const size_t window,
+    const size_t patch_x, const size_t patch_y, const double threshold) {
+
+    const auto size = points.size() / vector;
+    std::map<uint64_t, size_t> histogram;
+    for (auto j = first; j + patch_y <= size; j++)
+        for (auto i = first; i + patch_x <= size; i++) {
+            if (std::max(i + patch_x, j + patch_y) - std::min(i, j) > window) continue;
+
+            uint64_t microstate = 0;
+            for (size_t b = 0; b < patch_y; b++)
+                for (size_t a = 0; a < patch_x; a++) {
+                    double distance = 0.0;
+                    for (size_t k = 0; k < vector; k++) {
+                        const auto diff = points[(i + a) * vector + k] - points[(j + b) * vector + k];
+                        distance += diff * diff;
+                    }
+                    microstate |= static_cast<uint64_t>(std::sqrt(distance) <= threshold) << (a + b * patch_x);
+                }
+            histogram[microstate]++;
+        }
+
+    return histogram;
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * The histogram of the Stream, from its dense counts or its keys.
+std::map<uint64_t, size_t> histogram(const Stream &stream) {
+    std::map<uint64_t, size_t> result;
+    const auto counts = stream.counts();
+    const auto keys = stream.dictionary() ? stream.keys() : std::vector<uint64_t>();
+    for (size_t i = 0; i < counts.size(); i++)
+        if (counts[i] > 0) result[stream.dictionary() ? keys[i] : i] = counts[i];
+    return result;
+}
+//      -------------------------------------------------------------------------------------------------------
+void check_stream(const std::vector<size_t> &structure, const size_t vector, const size_t window, const bool expire, const unsigned short mode) {
+    const Settings settings(structure, 1, mode);
+    const double threshold = 0.4 * std::sqrt(static_cast<double>(vector));
+    Stream stream(settings, threshold, window, METRIC_EUCLIDEAN, expire);
+
+    std::mt19937_64 generator(1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> points;
+
+    //      Chunks shorter and longer than the window, each one given as (vector, count) so the values of a point
+    //  are count apart.
+    for (const size_t count : {1, 37, 5, 200, 64, 3, 91}) {
+        std::vector<double> chunk(vector * count);
+        for (size_t t = 0; t < count; t++)
+            for (size_t k = 0; k < vector; k++) {
+                chunk[k * count + t] = uniform(generator);
+                points.push_back(chunk[k * count + t]);
+            }
+        stream.push(chunk.data(), vector, count, static_cast<std::ptrdiff_t>(count), 1);
+
+        const auto seen = points.size() / vector;
+        const auto first = expire && seen > window ? seen - window : 0;
+        const auto expected = recompute(points, vector, first, window, structure[0], structure[1], threshold);
+
+        size_t total = 0;
+        for (const auto &[key, value] : expected) total += value;
+
+        const auto probabilities = stream.snapshot();
+        double sum = 0.0;
+        for (const auto p : probabilities) sum += p;
+
+        if (!CHECK(stream.size() == seen && stream.microstates() == total && histogram(stream) == expected &&
+            (total == 0 || std::abs(sum - 1.0) < 1e-9)))
+            std::printf("    structure %zu x %zu, vector %zu, window %zu, expire %d, points %zu\n", structure[0], structure[1], vector,
+                window, expire, seen);
+    }
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Two writers and a reader at once: every point and every microstate of the window are counted.
+void check_threads() {
+    const Settings settings({2, 2}, 1, MODE_FORCE_VECTOR);
+    Stream stream(settings, 0.3, 50);
+
+    const auto writer = [&](const uint64_t seed) {
+        std::mt19937_64 generator(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (size_t c = 0; c < 200; c++) {
+            double chunk[7];
+            for (auto &v : chunk) v = uniform(generator);
+            stream.push(chunk, 1, 7, 1, 1);
+        }
+    };
+
+    bool consistent = true;
+    std::thread first(writer, 1), second(writer, 2), reader([&] {
+        for (size_t r = 0; r < 500; r++) {
+            const auto counts = stream.counts();
+            size_t total = 0;
+            for (const auto c : counts) total += c;
+            consistent = consistent && total <= 49 * 49;
+        }
+    });
+    first.join();
+    second.join();
+    reader.join();
+
+    const auto counts = stream.counts();
+    size_t total = 0;
+    for (const auto c : counts) total += c;
+    CHECK(consistent && stream.size() == 2 * 200 * 7 && stream.microstates() == 49 * 49 && total == 49 * 49);
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    for (const bool expire : {true, false})
+        for (const unsigned short mode : {MODE_FORCE_VECTOR, MODE_FORCE_DICTIONARY}) {
+            check_stream({2, 2}, 1, 100, expire, mode);
+            check_stream({3, 2}, 2, 64, expire, mode);
+            check_stream({2, 4}, 3, 70, expire, mode);
+            check_stream({4, 4}, 1, 130, expire, mode);
+        }
+
+    check_threads();
+
+    return Testing::result();
+}
@@ -0,0 +1,111 @@
+//
+//          Python - Recurrence Microstates Library (MicroRecPy)
+//          Created by Gabriel Ferreira on February 2025.
+//          Advisors: Thiago de Lima Prado and Sérgio Roberto Lopes
+//          Federal University of Paraná - Physics Department
+//
+//      Julia version: https://github.com/gabriel-ferr/RecurrenceMicrostates.jl
+//      Python version: https://github.com/gabriel-ferr/MicroRecPy
+//      C++ version: https://github.com/gabriel-ferr/RecurrenceMicrostates (base for the MicroRecPy)
+//
+//      -------------------------------------------------------------------------------------------------------
+//          Thread pool tests .cpp body
+//      -------------------------------------------------------------------------------------------------------
+//          The shared pool under the uses that the library makes of it: parallel_for called at once from several
+//  threads, parallel_for nested in a job (run serially on the calling thread), and the pool grown by a Settings
+//  while a job is running. Every index must be given to the body exactly once.
+//      -------------------------------------------------------------------------------------------------------
+//                * Include the used libraries.
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+#include "threadpool.h"
+#include "check.h"
+//      -------------------------------------------------------------------------------------------------------
+using namespace RecurrenceMicrostates;
+//      -------------------------------------------------------------------------------------------------------
+//              * Whether every index was counted exactly once.
+bool once(const std::vector<std::atomic<unsigned int>> &hits) {
+    for (const auto &h : hits)
+        if (h.load() != 1) return false;
+    return true;
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * Several threads submitting to the pool at once, with more workers than its threads.
+void check_concurrent(ThreadPool &pool) {
+    constexpr size_t callers = 4;
+    constexpr size_t count = 20000;
+
+    std::vector<std::vector<std::atomic<unsigned int>>> hits;
+    for (size_t c = 0; c < callers; c++) hits.emplace_back(count);
+
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < callers; c++)
+        threads.emplace_back([&, c] {
+            for (size_t round = 0; round < 20; round++) {
+                if (round > 0)
+                    for (auto &h : hits[c]) h.store(0);
+                pool.parallel_for(count, static_cast<unsigned int>(3 + c), 7 + c, [&](unsigned int, const size_t begin, const size_t end) {
+                    for (auto i = begin; i < end; i++) hits[c][i].fetch_add(1);
+                });
+                if (!once(hits[c])) return;
+            }
+        });
+    for (auto &thread : threads) thread.join();
+
+    for (size_t c = 0; c < callers; c++)
+        if (!CHECK(once(hits[c]))) std::printf("    caller %zu\n", c);
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * A parallel_for in the body of another one runs on the thread of that body.
+void check_nested(ThreadPool &pool) {
+    constexpr size_t outer = 64;
+    constexpr size_t inner = 300;
+
+    std::vector<std::atomic<unsigned int>> hits(outer * inner);
+    std::atomic<bool> serial = true;
+    pool.parallel_for(outer, 4, 1, [&](unsigned int, const size_t begin, const size_t end) {
+        for (auto o = begin; o < end; o++) {
+            const auto caller = std::this_thread::get_id();
+            pool.parallel_for(inner, 4, 16, [&](unsigned int, const size_t first, const size_t last) {
+                if (std::this_thread::get_id() != caller) serial = false;
+                for (auto i = first; i < last; i++) hits[o * inner + i].fetch_add(1);
+            });
+        }
+    });
+
+    CHECK(once(hits) && serial);
+}
+//      -------------------------------------------------------------------------------------------------------
+//              * The pool grown from inside a job: the new threads only join the next jobs.
+void check_grow(ThreadPool &pool) {
+    constexpr size_t count = 50000;
+    const auto before = pool.size();
+
+    std::vector<std::atomic<unsigned int>> hits(count);
+    std::atomic<bool> grown = false;
+    pool.parallel_for(count, before, 5, [&](unsigned int, const size_t begin, const size_t end) {
+        if (!grown.exchange(true)) (void)ThreadPool::instance(before + 3);
+        for (auto i = begin; i < end; i++) hits[i].fetch_add(1);
+    });
+    CHECK(once(hits) && pool.size() >= before + 3);
+
+    //      The next job with all the threads, the new ones included.
+    std::vector<std::atomic<unsigned int>> again(count);
+    pool.parallel_for(count, pool.size(), 5, [&](unsigned int, const size_t begin, const size_t end) {
+        for (auto i = begin; i < end; i++) again[i].fetch_add(1);
+    });
+    CHECK(once(again));
+}
+//      -------------------------------------------------------------------------------------------------------
+int main() {
+    const auto pool = ThreadPool::instance(4);
+
+    check_concurrent(*pool);
+    check_nested(*pool);
+    check_grow(*pool);
+
+    return Testing::result();
+}